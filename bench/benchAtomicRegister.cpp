@@ -0,0 +1,89 @@
+/**
+ * @file benchAtomicRegister.cpp
+ * @brief field updates of a register shared between threads, atomic register
+ * against a mutex guarded register
+ *
+ */
+
+#include <AtomicRegister.h>
+#include <Register.h>
+
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+
+using namespace regs;
+
+namespace {
+
+struct Shared : AtomicRegister<Shared, uint32_t> {
+  using Flag = Field<Shared, 0, 1>;
+  using Owner = Field<Shared, 4, 4, 0, read_write, uint8_t>;
+};
+
+struct Plain : Register<Plain, uint32_t> {
+  using Flag = Field<Plain, 0, 1>;
+  using Owner = Field<Plain, 4, 4, 0, read_write, uint8_t>;
+};
+
+Shared shared;
+
+Plain plain;
+std::mutex plain_mutex;
+
+void BM_AtomicToggle(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(shared.toggle<Shared::Flag>());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_MutexToggle(benchmark::State &state) {
+  for (auto _ : state) {
+    std::lock_guard lock{plain_mutex};
+    plain.write<Plain::Flag>(!plain.read<Plain::Flag>());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_AtomicWrite(benchmark::State &state) {
+  auto owner = static_cast<uint8_t>(state.thread_index());
+  for (auto _ : state) {
+    shared.write<Shared::Owner>(owner);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_MutexWrite(benchmark::State &state) {
+  auto owner = static_cast<uint8_t>(state.thread_index());
+  for (auto _ : state) {
+    std::lock_guard lock{plain_mutex};
+    plain.write<Plain::Owner>(owner);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_AtomicRead(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        shared.read<Shared::Owner>(std::memory_order_acquire));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_MutexRead(benchmark::State &state) {
+  for (auto _ : state) {
+    std::lock_guard lock{plain_mutex};
+    benchmark::DoNotOptimize(plain.read<Plain::Owner>());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(BM_AtomicToggle)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_MutexToggle)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_AtomicWrite)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_MutexWrite)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_AtomicRead)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_MutexRead)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,107 @@
+/**
+ * @file benchCaptureFile.cpp
+ * @brief replaying a recorded capture: ifstream into a buffer against the
+ * memory mapped CaptureFile, both reading one register of every frame
+ *
+ */
+
+#include <CaptureFile.h>
+#include <RegisterPack.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace regs;
+
+namespace {
+
+struct Header : RegisterPack<16> {
+  using RegisterPack::RegisterPack;
+
+  struct total_length : PackedRegister<Header, total_length, 8, uint32_t> {};
+  struct frame_no : PackedRegister<Header, frame_no, 12, uint32_t> {};
+};
+
+using Capture = CaptureFile<Header, Header::total_length>;
+
+constexpr std::size_t kFrameCount = 1 << 16;
+
+/**
+ * @brief capture of frames between 256 and 1264 bytes, written once
+ *
+ */
+const std::string &capture_path() {
+  static const std::string path = [] {
+    std::string name = "/tmp/regs_bench_captureXXXXXX";
+    const int fd = ::mkstemp(name.data());
+    ::close(fd);
+
+    std::ofstream out{name, std::ios::binary};
+    std::vector<char> frame(2048);
+
+    for (uint32_t i = 0; i < kFrameCount; i++) {
+      const uint32_t length = 256 + i % 64 * 16;
+      std::memcpy(frame.data() + 8, &length, 4);
+      std::memcpy(frame.data() + 12, &i, 4);
+      out.write(frame.data(), length);
+    }
+
+    std::atexit([] { std::remove(capture_path().c_str()); });
+    return name;
+  }();
+
+  return path;
+}
+
+void BM_Ifstream(benchmark::State &state) {
+  const auto &path = capture_path();
+  std::vector<std::byte> buffer(2048);
+
+  for (auto _ : state) {
+    std::ifstream in{path, std::ios::binary};
+    uint64_t sum = 0;
+    std::size_t bytes = 0;
+
+    while (in.read(reinterpret_cast<char *>(buffer.data()), 16)) {
+      const auto length = Header::total_length::decode(buffer);
+      in.read(reinterpret_cast<char *>(buffer.data()) + 16, length - 16);
+      sum += Header::frame_no::decode(buffer);
+      bytes += length;
+    }
+
+    benchmark::DoNotOptimize(sum);
+    state.SetBytesProcessed(state.bytes_processed() +
+                            static_cast<int64_t>(bytes));
+  }
+
+  state.SetItemsProcessed(state.iterations() * kFrameCount);
+}
+
+void BM_CaptureFile(benchmark::State &state) {
+  const auto &path = capture_path();
+
+  for (auto _ : state) {
+    auto capture = Capture::open(path.c_str());
+    uint64_t sum = 0;
+
+    for (auto frame : *capture) {
+      sum += frame.decode<Header::frame_no>();
+    }
+
+    benchmark::DoNotOptimize(sum);
+    state.SetBytesProcessed(state.bytes_processed() +
+                            static_cast<int64_t>(capture->bytes().size()));
+  }
+
+  state.SetItemsProcessed(state.iterations() * kFrameCount);
+}
+
+} // namespace
+
+BENCHMARK(BM_Ifstream)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CaptureFile)->Unit(benchmark::kMillisecond);
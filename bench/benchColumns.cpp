@@ -0,0 +1,103 @@
+/**
+ * @file benchColumns.cpp
+ * @brief decoding repeated point records into separate columns, record by
+ * record against the batched column decoder
+ *
+ */
+
+#include <RegisterArray.h>
+#include <RegisterPack.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace regs;
+
+namespace {
+
+struct PointValue {
+  float x;
+  float y;
+  float z;
+  float v;
+};
+
+struct Points : RegisterPack<16> {
+  using RegisterPack::RegisterPack;
+};
+
+template <unsigned Offset>
+struct Point : PackedRegister<Points, Point<Offset>, Offset, PointValue> {
+  using PackedRegister<Points, Point<Offset>, Offset,
+                       PointValue>::PackedRegister;
+
+  using x = Field<Point<Offset>, 0, 32, 0, read_only, float>;
+  using y = Field<Point<Offset>, 0, 32, 4, read_only, float>;
+  using z = Field<Point<Offset>, 0, 32, 8, read_only, float>;
+  using v = Field<Point<Offset>, 0, 32, 12, read_only, float>;
+};
+
+using PointArray = RegisterArray<Point, 0, 1>;
+using P = PointArray::reg<0>;
+
+struct Columns {
+  explicit Columns(std::size_t count) : x(count), y(count), z(count), v(count) {}
+
+  std::vector<float> x, y, z, v;
+};
+
+std::vector<std::byte> make_records(std::size_t count) {
+  std::vector<std::byte> records(count * sizeof(PointValue));
+  for (std::size_t i = 0; i < count; i++) {
+    PointValue point{float(i), float(i) + 1, float(i) + 2, float(i) + 3};
+    std::memcpy(records.data() + i * sizeof(PointValue), &point,
+                sizeof(point));
+  }
+  return records;
+}
+
+void BM_DecodePerRecord(benchmark::State &state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  auto records = make_records(count);
+  Columns columns{count};
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < count; i++) {
+      auto point = PointArray::decode(records, i);
+      columns.x[i] = point.x;
+      columns.y[i] = point.y;
+      columns.z[i] = point.z;
+      columns.v[i] = point.v;
+    }
+    benchmark::DoNotOptimize(columns.x.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(records.size()));
+}
+
+void BM_DecodeColumns(benchmark::State &state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  auto records = make_records(count);
+  Columns columns{count};
+
+  for (auto _ : state) {
+    PointArray::decode_columns<P::x, P::y, P::z, P::v>(
+        records, count, columns.x, columns.y, columns.z, columns.v);
+    benchmark::DoNotOptimize(columns.x.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(records.size()));
+}
+
+} // namespace
+
+BENCHMARK(BM_DecodePerRecord)->RangeMultiplier(8)->Range(64, 32768);
+BENCHMARK(BM_DecodeColumns)->RangeMultiplier(8)->Range(64, 32768);
@@ -0,0 +1,196 @@
+/**
+ * @file benchFields.cpp
+ * @brief field reads and writes over a buffer of registers, masked fields
+ * for a range of offsets and widths against byte aligned trivial fields,
+ * enum fields and a register wider than a native word
+ *
+ */
+
+#include <Register.h>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace regs;
+
+namespace {
+
+constexpr std::size_t kRegisterCount = 1024;
+
+template <unsigned Offset, unsigned Width, typename Value>
+struct Reg64 : Register<Reg64<Offset, Width, Value>, uint64_t> {
+  using Value_ = Field<Reg64, Offset, Width, 0, read_write, Value>;
+};
+
+enum class Mode : uint8_t { Off = 0, Slow = 1, Fast = 2, Turbo = 3 };
+
+struct ModeReg : Register<ModeReg, uint32_t> {
+  using Masked = Field<ModeReg, 13, 2, 0, read_write, Mode>;
+  using Trivial = Field<ModeReg, 8, 8, 0, read_write, Mode>;
+  using Flag = Field<ModeReg, 20, 1>;
+  using OtherFlag = Field<ModeReg, 27, 1>;
+};
+
+struct WideValue {
+  uint64_t words[2];
+};
+
+template <unsigned Offset, unsigned Width>
+struct Reg128 : Register<Reg128<Offset, Width>, WideValue> {
+  using Value_ = Field<Reg128, Offset, Width, 0, read_write, uint64_t>;
+};
+
+template <typename Reg> std::vector<Reg> make_registers() {
+  std::vector<Reg> registers(kRegisterCount);
+  for (std::size_t i = 0; i < registers.size(); i++) {
+    auto target = registers[i].span();
+    for (std::size_t b = 0; b < target.size(); b++) {
+      target[b] = std::byte(i * 31 + b * 7);
+    }
+  }
+  return registers;
+}
+
+template <typename Reg>
+void report(benchmark::State &state) {
+  state.SetItemsProcessed(state.iterations() * kRegisterCount);
+  state.SetBytesProcessed(state.iterations() * kRegisterCount *
+                          sizeof(typename Reg::reg_type));
+}
+
+template <typename Reg, typename TField>
+void BM_Read(benchmark::State &state) {
+  auto registers = make_registers<Reg>();
+
+  for (auto _ : state) {
+    for (auto &reg : registers) {
+      benchmark::DoNotOptimize(reg.template read<TField>());
+    }
+  }
+
+  report<Reg>(state);
+}
+
+template <typename Reg, typename TField>
+void BM_Write(benchmark::State &state) {
+  auto registers = make_registers<Reg>();
+
+  for (auto _ : state) {
+    typename TField::value_type value{};
+    for (auto &reg : registers) {
+      reg.template write<TField>(value);
+    }
+    benchmark::ClobberMemory();
+  }
+
+  report<Reg>(state);
+}
+
+template <typename Reg, typename TField>
+void BM_WriteOne(benchmark::State &state) {
+  auto registers = make_registers<Reg>();
+
+  for (auto _ : state) {
+    for (auto &reg : registers) {
+      reg.template write<TField>(1);
+    }
+    benchmark::ClobberMemory();
+  }
+
+  report<Reg>(state);
+}
+
+template <typename Reg, typename... TFields>
+void BM_Set(benchmark::State &state) {
+  auto registers = make_registers<Reg>();
+
+  for (auto _ : state) {
+    for (auto &reg : registers) {
+      reg.template set<TFields...>();
+    }
+    benchmark::ClobberMemory();
+  }
+
+  report<Reg>(state);
+}
+
+template <typename Reg, typename... TFields>
+void BM_Test(benchmark::State &state) {
+  auto registers = make_registers<Reg>();
+
+  for (auto _ : state) {
+    for (auto &reg : registers) {
+      benchmark::DoNotOptimize(reg.template test<TFields...>());
+    }
+  }
+
+  report<Reg>(state);
+}
+
+template <unsigned Offset, unsigned Width, typename Value = uint64_t>
+void BM_Read64(benchmark::State &state) {
+  using Reg = Reg64<Offset, Width, Value>;
+  BM_Read<Reg, typename Reg::Value_>(state);
+}
+
+template <unsigned Offset, unsigned Width, typename Value = uint64_t>
+void BM_Write64(benchmark::State &state) {
+  using Reg = Reg64<Offset, Width, Value>;
+  BM_Write<Reg, typename Reg::Value_>(state);
+}
+
+template <unsigned Offset, unsigned Width>
+void BM_Read128(benchmark::State &state) {
+  using Reg = Reg128<Offset, Width>;
+  BM_Read<Reg, typename Reg::Value_>(state);
+}
+
+template <unsigned Offset, unsigned Width>
+void BM_Write128(benchmark::State &state) {
+  using Reg = Reg128<Offset, Width>;
+  BM_Write<Reg, typename Reg::Value_>(state);
+}
+
+} // namespace
+
+// masked fields
+BENCHMARK_TEMPLATE(BM_Read64, 0, 1);
+BENCHMARK_TEMPLATE(BM_Read64, 3, 5);
+BENCHMARK_TEMPLATE(BM_Read64, 20, 6);
+BENCHMARK_TEMPLATE(BM_Read64, 29, 12);
+BENCHMARK_TEMPLATE(BM_Read64, 45, 19);
+BENCHMARK_TEMPLATE(BM_Write64, 0, 1);
+BENCHMARK_TEMPLATE(BM_Write64, 3, 5);
+BENCHMARK_TEMPLATE(BM_Write64, 20, 6);
+BENCHMARK_TEMPLATE(BM_Write64, 29, 12);
+BENCHMARK_TEMPLATE(BM_Write64, 45, 19);
+
+// trivial fields, whole bytes
+BENCHMARK_TEMPLATE(BM_Read64, 8, 8, uint8_t);
+BENCHMARK_TEMPLATE(BM_Read64, 16, 16, uint16_t);
+BENCHMARK_TEMPLATE(BM_Read64, 32, 32, uint32_t);
+BENCHMARK_TEMPLATE(BM_Write64, 8, 8, uint8_t);
+BENCHMARK_TEMPLATE(BM_Write64, 16, 16, uint16_t);
+BENCHMARK_TEMPLATE(BM_Write64, 32, 32, uint32_t);
+
+// enum fields
+BENCHMARK_TEMPLATE(BM_Read, ModeReg, ModeReg::Masked);
+BENCHMARK_TEMPLATE(BM_Read, ModeReg, ModeReg::Trivial);
+BENCHMARK_TEMPLATE(BM_Write, ModeReg, ModeReg::Masked);
+BENCHMARK_TEMPLATE(BM_Write, ModeReg, ModeReg::Trivial);
+
+// single bit flags, written as value against set/test
+BENCHMARK_TEMPLATE(BM_WriteOne, ModeReg, ModeReg::Flag);
+BENCHMARK_TEMPLATE(BM_Set, ModeReg, ModeReg::Flag);
+BENCHMARK_TEMPLATE(BM_Set, ModeReg, ModeReg::Flag, ModeReg::OtherFlag);
+BENCHMARK_TEMPLATE(BM_Read, ModeReg, ModeReg::Flag);
+BENCHMARK_TEMPLATE(BM_Test, ModeReg, ModeReg::Flag);
+
+// registers without native word
+BENCHMARK_TEMPLATE(BM_Read128, 4, 12);
+BENCHMARK_TEMPLATE(BM_Read128, 60, 8);
+BENCHMARK_TEMPLATE(BM_Read128, 70, 40);
+BENCHMARK_TEMPLATE(BM_Write128, 4, 12);
+BENCHMARK_TEMPLATE(BM_Write128, 60, 8);
+BENCHMARK_TEMPLATE(BM_Write128, 70, 40);
@@ -0,0 +1,250 @@
+/**
+ * @file benchFrameDecode.cpp
+ * @brief decoding point cloud frames laid out as in testBinaryParsing, from
+ * a contiguous frame, from an unframed byte stream and from a frame split
+ * over several receive buffers
+ *
+ */
+
+#include <FrameStream.h>
+#include <RegisterArray.h>
+#include <RegisterPack.h>
+#include <SegmentedPack.h>
+#include <Tlv.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace regs;
+
+namespace {
+
+struct FrameHeader : RegisterPack<40> {
+  using RegisterPack::RegisterPack;
+
+  struct total_length
+      : PackedRegister<FrameHeader, total_length, 12, uint32_t> {};
+  struct detect_obj_no
+      : PackedRegister<FrameHeader, detect_obj_no, 28, uint32_t> {};
+  struct tlvs_no : PackedRegister<FrameHeader, tlvs_no, 32, uint32_t> {};
+};
+
+struct TlvHeader : RegisterPack<8> {
+  using RegisterPack::RegisterPack;
+
+  struct TlvType : PackedRegister<TlvHeader, TlvType, 0, uint32_t> {};
+  struct Length : PackedRegister<TlvHeader, Length, 4, uint32_t> {};
+};
+
+struct PointValue {
+  float x;
+  float y;
+  float z;
+  float v;
+};
+
+struct Points : RegisterPack<16> {
+  using RegisterPack::RegisterPack;
+};
+
+template <unsigned Offset>
+struct Point : PackedRegister<Points, Point<Offset>, Offset, PointValue> {
+  using PackedRegister<Points, Point<Offset>, Offset,
+                       PointValue>::PackedRegister;
+
+  using x = Field<Point<Offset>, 0, 32, 0, read_only, float>;
+  using y = Field<Point<Offset>, 0, 32, 4, read_only, float>;
+  using z = Field<Point<Offset>, 0, 32, 8, read_only, float>;
+  using v = Field<Point<Offset>, 0, 32, 12, read_only, float>;
+};
+
+using PointArray = RegisterArray<Point, 0, 1>;
+using P = PointArray::reg<0>;
+
+using FrameTlvs = TlvRange<TlvHeader, TlvHeader::TlvType, TlvHeader::Length>;
+
+constexpr byte_array<8> kMagic = {0x02_b, 0x01_b, 0x04_b, 0x03_b,
+                                  0x06_b, 0x05_b, 0x08_b, 0x07_b};
+
+template <typename T> void put(std::vector<std::byte> &frame, T value) {
+  auto offset = frame.size();
+  frame.resize(offset + sizeof(T));
+  std::memcpy(frame.data() + offset, &value, sizeof(T));
+}
+
+/**
+ * @brief frame with one TLV of count points
+ *
+ */
+std::vector<std::byte> make_frame(uint32_t count) {
+  std::vector<std::byte> frame(kMagic.begin(), kMagic.end());
+
+  const uint32_t payload = count * sizeof(PointValue);
+
+  put<uint32_t>(frame, 0x03050004);                 // version
+  put<uint32_t>(frame, 40 + 8 + payload);           // total length
+  put<uint32_t>(frame, 0x3f96f3b6);                 // platform
+  put<uint32_t>(frame, 29);                         // frame no
+  put<uint32_t>(frame, 2890657403);                 // time cpu cycle
+  put<uint32_t>(frame, count);                      // detect obj no
+  put<uint32_t>(frame, 1);                          // tlvs no
+  put<uint32_t>(frame, 0);                          // sub frame no
+  put<uint32_t>(frame, 1);                          // tlv type
+  put<uint32_t>(frame, payload);                    // tlv length
+
+  for (uint32_t i = 0; i < count; i++) {
+    put(frame, PointValue{float(i), float(i) * 0.5f, -float(i), 0.0f});
+  }
+
+  return frame;
+}
+
+struct Columns {
+  explicit Columns(std::size_t count) : x(count), y(count), z(count), v(count) {}
+
+  std::vector<float> x, y, z, v;
+};
+
+std::size_t decode(std::span<const std::byte> frame, Columns &columns) {
+  const auto count = FrameHeader::detect_obj_no::decode(frame);
+  std::size_t decoded = 0;
+
+  for (const auto &tlv :
+       FrameTlvs::from_frame<FrameHeader::total_length, FrameHeader::tlvs_no>(
+           frame)) {
+    if (tlv.type == 1 && tlv.payload.size() >= count * sizeof(PointValue)) {
+      PointArray::decode_columns<P::x, P::y, P::z, P::v>(
+          tlv.payload, count, columns.x, columns.y, columns.z, columns.v);
+      decoded += count;
+    }
+  }
+
+  return decoded;
+}
+
+void BM_FrameDecode(benchmark::State &state) {
+  const auto count = static_cast<uint32_t>(state.range(0));
+  const auto frame = make_frame(count);
+  Columns columns{count};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(decode(frame, columns));
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(frame.size()));
+}
+
+/**
+ * @brief frames pushed in chunks of 1500 bytes with a few garbage bytes in
+ * between, each frame is decoded once complete
+ *
+ */
+void BM_StreamDecode(benchmark::State &state) {
+  const auto count = static_cast<uint32_t>(state.range(0));
+
+  auto stream_bytes = make_frame(count);
+  stream_bytes.insert(stream_bytes.begin(), 13, std::byte{0x02});
+
+  FrameStream<FrameHeader, FrameHeader::total_length, 1 << 20> stream{kMagic};
+  Columns columns{count};
+  std::vector<std::byte> linear(stream_bytes.size());
+
+  constexpr std::size_t kChunk = 1500;
+
+  for (auto _ : state) {
+    std::span<const std::byte> rest{stream_bytes};
+
+    while (!rest.empty()) {
+      auto taken = stream.push(rest.first(std::min(kChunk, rest.size())));
+      rest = rest.subspan(taken);
+
+      while (auto frame = stream.next()) {
+        if (frame->contiguous()) {
+          benchmark::DoNotOptimize(decode(frame->first, columns));
+        } else {
+          frame->copy_to(std::span{linear}.first(frame->size()));
+          benchmark::DoNotOptimize(
+              decode(std::span{linear}.first(frame->size()), columns));
+        }
+      }
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(stream_bytes.size()));
+}
+
+/**
+ * @brief frame split in receive buffers of 1500 bytes
+ *
+ */
+std::vector<std::span<const std::byte>>
+split(std::span<const std::byte> frame) {
+  constexpr std::size_t kChunk = 1500;
+
+  std::vector<std::span<const std::byte>> segments;
+  for (std::size_t i = 0; i < frame.size(); i += kChunk) {
+    segments.push_back(frame.subspan(i, std::min(kChunk, frame.size() - i)));
+  }
+  return segments;
+}
+
+/**
+ * @brief header and TLV header of a segmented frame, gathered into one
+ * buffer first
+ *
+ */
+void BM_GatherHeaders(benchmark::State &state) {
+  const auto frame = make_frame(static_cast<uint32_t>(state.range(0)));
+  const auto segments = split(frame);
+  std::vector<std::byte> linear(frame.size());
+
+  for (auto _ : state) {
+    auto *out = linear.data();
+    for (auto segment : segments) {
+      std::memcpy(out, segment.data(), segment.size());
+      out += segment.size();
+    }
+
+    std::span<const std::byte> bytes{linear};
+    benchmark::DoNotOptimize(FrameHeader::total_length::decode(bytes));
+    benchmark::DoNotOptimize(FrameHeader::detect_obj_no::decode(bytes));
+    benchmark::DoNotOptimize(FrameHeader::tlvs_no::decode(bytes));
+    benchmark::DoNotOptimize(TlvHeader::Length::decode(bytes.subspan(40)));
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief the same reads through SegmentedPack, without the copy
+ *
+ */
+void BM_SegmentedHeaders(benchmark::State &state) {
+  const auto frame = make_frame(static_cast<uint32_t>(state.range(0)));
+  const auto segments = split(frame);
+
+  for (auto _ : state) {
+    SegmentedPack<FrameHeader> header{segments};
+    benchmark::DoNotOptimize(header.decode<FrameHeader::total_length>());
+    benchmark::DoNotOptimize(header.decode<FrameHeader::detect_obj_no>());
+    benchmark::DoNotOptimize(header.decode<FrameHeader::tlvs_no>());
+    benchmark::DoNotOptimize(
+        header.overlay<TlvHeader>(40).decode<TlvHeader::Length>());
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(BM_FrameDecode)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_StreamDecode)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_GatherHeaders)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_SegmentedHeaders)->RangeMultiplier(8)->Range(8, 4096);
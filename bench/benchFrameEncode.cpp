@@ -0,0 +1,94 @@
+/**
+ * @file benchFrameEncode.cpp
+ * @brief encoding command frames: one PackedRegister after the other with a
+ * length fixup at the end, against FrameBuilder
+ *
+ */
+
+#include <FrameBuilder.h>
+#include <RegisterPack.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+using namespace regs;
+
+namespace {
+
+struct CommandHeader : RegisterPack<24> {
+  using RegisterPack::RegisterPack;
+
+  struct Magic : PackedRegister<CommandHeader, Magic, 0, uint32_t> {};
+  struct Version : PackedRegister<CommandHeader, Version, 4, uint16_t> {};
+  struct Opcode : PackedRegister<CommandHeader, Opcode, 6, uint16_t> {};
+  struct Length : PackedRegister<CommandHeader, Length, 8, uint32_t,
+                                 std::endian::big> {};
+  struct Sequence : PackedRegister<CommandHeader, Sequence, 12, uint32_t> {};
+  struct Timestamp
+      : PackedRegister<CommandHeader, Timestamp, 16, uint64_t> {};
+};
+
+using CommandBuilder =
+    FrameBuilder<CommandHeader, Fixed<CommandHeader::Magic, 0xC0DEFEEDu>,
+                 Fixed<CommandHeader::Version, uint16_t{3}>,
+                 Fixed<CommandHeader::Opcode, uint16_t{0x21}>,
+                 TotalLength<CommandHeader::Length>, CommandHeader::Sequence,
+                 CommandHeader::Timestamp>;
+
+constexpr std::size_t kHeaderSize = sizeof(CommandHeader::target_type);
+constexpr std::size_t kPayloadSize = 32;
+
+template <typename Reg>
+void copy_register(std::byte *out, typename Reg::reg_type value) {
+  const auto bytes = details::to_bytes<details::byte_order_of<Reg>()>(value);
+  std::copy(bytes.begin(), bytes.end(), out + Reg::offset);
+}
+
+void BM_PerRegister(benchmark::State &state) {
+  std::array<std::byte, 64> out{};
+  std::array<std::byte, kPayloadSize> payload{};
+  uint32_t sequence = 0;
+
+  for (auto _ : state) {
+    auto *frame = out.data();
+    std::fill_n(frame, kHeaderSize, std::byte{});
+    copy_register<CommandHeader::Magic>(frame, 0xC0DEFEEDu);
+    copy_register<CommandHeader::Version>(frame, 3);
+    copy_register<CommandHeader::Opcode>(frame, 0x21);
+    sequence++;
+    copy_register<CommandHeader::Sequence>(frame, sequence);
+    copy_register<CommandHeader::Timestamp>(frame, sequence);
+    std::copy(payload.begin(), payload.end(), frame + kHeaderSize);
+    copy_register<CommandHeader::Length>(
+        frame, static_cast<uint32_t>(kHeaderSize + payload.size()));
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_FrameBuilder(benchmark::State &state) {
+  std::array<std::byte, 64> out{};
+  std::array<std::byte, kPayloadSize> payload{};
+  uint32_t sequence = 0;
+
+  for (auto _ : state) {
+    sequence++;
+    auto size = CommandBuilder::encode(out, payload, sequence,
+                                       uint64_t{sequence});
+    benchmark::DoNotOptimize(size);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(BM_PerRegister);
+BENCHMARK(BM_FrameBuilder);
@@ -0,0 +1,89 @@
+/**
+ * @file benchPackDelta.cpp
+ * @brief shipping the state of a large config pack: full snapshot against the
+ * delta to the previous snapshot, with about 1% of the bytes changed
+ *
+ */
+
+#include <RegisterPack.h>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace regs;
+
+namespace {
+
+struct ConfigBlock : RegisterPack<4096> {
+  using RegisterPack::RegisterPack;
+};
+
+/**
+ * @brief changes every 100th byte of the pack
+ *
+ */
+void touch(ConfigBlock &pack, std::byte value) {
+  for (std::size_t i = 0; i < sizeof(ConfigBlock::target_type); i += 100) {
+    pack._target[i] = value;
+  }
+}
+
+void BM_FullSnapshot(benchmark::State &state) {
+  ConfigBlock pack;
+  std::vector<std::byte> wire(sizeof(ConfigBlock::target_type));
+  std::byte value{};
+
+  for (auto _ : state) {
+    touch(pack, value = ~value);
+    auto snapshot = pack.snapshot();
+    std::copy(snapshot.begin(), snapshot.end(), wire.begin());
+    benchmark::DoNotOptimize(wire.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(wire.size()));
+}
+
+void BM_Delta(benchmark::State &state) {
+  ConfigBlock pack;
+  auto previous = pack.snapshot();
+  PackDelta delta;
+  std::byte value{};
+
+  for (auto _ : state) {
+    touch(pack, value = ~value);
+    auto snapshot = pack.snapshot();
+    ConfigBlock::diff(previous, snapshot, delta);
+    previous = snapshot;
+    benchmark::DoNotOptimize(delta.bytes().data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(sizeof(previous)));
+}
+
+void BM_Apply(benchmark::State &state) {
+  ConfigBlock pack;
+  ConfigBlock changed;
+  touch(changed, std::byte{1});
+
+  auto delta = ConfigBlock::diff(pack.snapshot(), changed.snapshot());
+
+  for (auto _ : state) {
+    pack.apply(delta);
+    benchmark::DoNotOptimize(pack._target.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(delta.ranges().size()));
+}
+
+} // namespace
+
+BENCHMARK(BM_FullSnapshot);
+BENCHMARK(BM_Delta);
+BENCHMARK(BM_Apply);
@@ -0,0 +1,202 @@
+/**
+ * @file benchRuntimeIndex.cpp
+ * @brief runtime indexed FieldArray and RegisterArray access for growing
+ * element counts, the latency per access should stay flat, compile-time
+ * indexed access of all elements as reference
+ *
+ */
+
+#include <Register.h>
+#include <RegisterArray.h>
+#include <RegisterPack.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace regs;
+
+namespace {
+
+constexpr std::size_t kIndexCount = 1024;
+
+/**
+ * @brief random indexes so the branch predictor cannot learn the pattern
+ *
+ */
+std::vector<std::size_t> random_indexes(std::size_t count) {
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<std::size_t> distribution{0, count - 1};
+
+  std::vector<std::size_t> indexes(kIndexCount);
+  for (auto &index : indexes) {
+    index = distribution(generator);
+  }
+
+  return indexes;
+}
+
+template <std::size_t Count>
+struct Lanes : Register<Lanes<Count>, uint64_t> {
+  using Register<Lanes<Count>, uint64_t>::Register;
+
+  using Lane = FieldArray<Lanes<Count>, 0, 64 / Count, Count>;
+};
+
+template <std::size_t Count> struct Bank : RegisterPack<Count * 4> {
+  using RegisterPack<Count * 4>::RegisterPack;
+};
+
+template <std::size_t Count> struct BankRegister {
+  template <unsigned Offset>
+  struct type
+      : PackedRegister<Bank<Count>, type<Offset>, Offset, uint32_t> {
+    using PackedRegister<Bank<Count>, type<Offset>, Offset,
+                         uint32_t>::PackedRegister;
+  };
+};
+
+template <std::size_t Count>
+using BankArray =
+    RegisterArray<BankRegister<Count>::template type, 0, Count, 4>;
+
+template <std::size_t Count>
+void BM_FieldArrayRuntimeRead(benchmark::State &state) {
+  Lanes<Count> reg;
+  reg.write(0x0123456789ABCDEF);
+
+  const auto indexes = random_indexes(Count);
+  std::size_t i = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(reg.template read<typename Lanes<Count>::Lane>(
+        indexes[i++ % kIndexCount]));
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <std::size_t Count>
+void BM_FieldArrayRuntimeWrite(benchmark::State &state) {
+  Lanes<Count> reg;
+
+  const auto indexes = random_indexes(Count);
+  std::size_t i = 0;
+
+  for (auto _ : state) {
+    const auto index = indexes[i++ % kIndexCount];
+    reg.template write<typename Lanes<Count>::Lane>(index, index);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <std::size_t Count, std::size_t... Index>
+void read_lanes(Lanes<Count> &reg, std::index_sequence<Index...>) {
+  (benchmark::DoNotOptimize(
+       reg.template read<typename Lanes<Count>::Lane, Index>()),
+   ...);
+}
+
+template <std::size_t Count>
+void BM_FieldArrayStaticRead(benchmark::State &state) {
+  Lanes<Count> reg;
+  reg.write(0x0123456789ABCDEF);
+
+  for (auto _ : state) {
+    // the register may have changed, so every iteration reloads it
+    benchmark::DoNotOptimize(reg);
+    read_lanes(reg, std::make_index_sequence<Count>{});
+  }
+
+  state.SetItemsProcessed(state.iterations() * Count);
+}
+
+// the reads are combined, a register passed on as is would be handed to
+// DoNotOptimize as memory operand without ever being loaded
+template <std::size_t Count, std::size_t... Index>
+uint32_t read_bank(Bank<Count> &bank, std::index_sequence<Index...>) {
+  return (BankArray<Count>::template read<Index>(bank) ^ ...);
+}
+
+template <std::size_t Count>
+void BM_RegisterArrayStaticRead(benchmark::State &state) {
+  Bank<Count> bank;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(bank);
+    benchmark::DoNotOptimize(
+        read_bank(bank, std::make_index_sequence<Count>{}));
+  }
+
+  state.SetItemsProcessed(state.iterations() * Count);
+  state.SetBytesProcessed(state.iterations() * Count * 4);
+}
+
+template <std::size_t Count>
+void BM_RegisterArrayRuntimeRead(benchmark::State &state) {
+  Bank<Count> bank;
+
+  const auto indexes = random_indexes(Count);
+  std::size_t i = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        BankArray<Count>::read(bank, indexes[i++ % kIndexCount]));
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * 4);
+}
+
+template <std::size_t Count>
+void BM_RegisterArrayRuntimeWrite(benchmark::State &state) {
+  Bank<Count> bank;
+
+  const auto indexes = random_indexes(Count);
+  std::size_t i = 0;
+
+  for (auto _ : state) {
+    const auto index = indexes[i++ % kIndexCount];
+    BankArray<Count>::write(bank, index, static_cast<uint32_t>(index));
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * 4);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_FieldArrayRuntimeRead, 4);
+BENCHMARK_TEMPLATE(BM_FieldArrayRuntimeRead, 8);
+BENCHMARK_TEMPLATE(BM_FieldArrayRuntimeRead, 16);
+BENCHMARK_TEMPLATE(BM_FieldArrayRuntimeRead, 32);
+BENCHMARK_TEMPLATE(BM_FieldArrayRuntimeRead, 64);
+
+BENCHMARK_TEMPLATE(BM_FieldArrayRuntimeWrite, 4);
+BENCHMARK_TEMPLATE(BM_FieldArrayRuntimeWrite, 8);
+BENCHMARK_TEMPLATE(BM_FieldArrayRuntimeWrite, 16);
+BENCHMARK_TEMPLATE(BM_FieldArrayRuntimeWrite, 32);
+BENCHMARK_TEMPLATE(BM_FieldArrayRuntimeWrite, 64);
+
+BENCHMARK_TEMPLATE(BM_FieldArrayStaticRead, 4);
+BENCHMARK_TEMPLATE(BM_FieldArrayStaticRead, 16);
+BENCHMARK_TEMPLATE(BM_FieldArrayStaticRead, 64);
+
+BENCHMARK_TEMPLATE(BM_RegisterArrayStaticRead, 4);
+BENCHMARK_TEMPLATE(BM_RegisterArrayStaticRead, 16);
+BENCHMARK_TEMPLATE(BM_RegisterArrayStaticRead, 64);
+
+BENCHMARK_TEMPLATE(BM_RegisterArrayRuntimeRead, 4);
+BENCHMARK_TEMPLATE(BM_RegisterArrayRuntimeRead, 16);
+BENCHMARK_TEMPLATE(BM_RegisterArrayRuntimeRead, 64);
+BENCHMARK_TEMPLATE(BM_RegisterArrayRuntimeRead, 256);
+
+BENCHMARK_TEMPLATE(BM_RegisterArrayRuntimeWrite, 4);
+BENCHMARK_TEMPLATE(BM_RegisterArrayRuntimeWrite, 16);
+BENCHMARK_TEMPLATE(BM_RegisterArrayRuntimeWrite, 64);
+BENCHMARK_TEMPLATE(BM_RegisterArrayRuntimeWrite, 256);
@@ -64,5 +64,15 @@ int main() {
   iocr_word = IOCRArray::read<2>(port);
   std::cout << "IOCR[2] after = 0x" << std::hex << iocr_word << std::endl;
 
+  // Whole port at once: one read-modify-write per IOCR register.
+  IOCRArray::for_each(port, [](std::size_t, auto iocr) {
+    using PC = typename decltype(iocr)::PC;
+    iocr.template fill<PC>(0x10);
+  });
+
+  for (auto word : IOCRArray::read_all(port)) {
+    std::cout << "IOCR = 0x" << std::hex << word << std::endl;
+  }
+
   return 0;
 }
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "Register.h"
+#include "RegisterBase.h"
+#include <atomic>
+#include <type_traits>
+
+namespace regs {
+
+/**
+ * @brief Register shared between threads, e.g. a status word in shared
+ * memory
+ *
+ * The register holds its word like Register does and can be placed onto
+ * shared memory with placement new. Every access goes through
+ * std::atomic_ref: reads are a single atomic load, field writes a
+ * compare-exchange loop, set/clear/toggle a single fetch_or/fetch_and/
+ * fetch_xor.
+ *
+ * @tparam Reg derived register
+ * @tparam Reg_type underlying integral type
+ */
+template <typename Reg, typename Reg_type>
+class AtomicRegister : public RegisterBase<Reg, Reg_type> {
+ public:
+
+ using reg = Reg;
+ using reg_type = Reg_type;
+
+ static constexpr size_t size = sizeof(reg_type);
+
+ using target_type = byte_array<size>;
+
+ using word_type = uint_for_bytes_t<size>;
+
+ static constexpr bool is_atomic = true;
+
+ static_assert(std::is_integral_v<reg_type>,
+               "atomic registers need an integral type");
+ static_assert(std::atomic_ref<reg_type>::is_always_lock_free,
+               "atomic register type is not lock free");
+
+ private:
+
+ using base = RegisterBase<Reg, Reg_type>;
+
+ alignas(std::atomic_ref<reg_type>::required_alignment) reg_type _value;
+
+ std::atomic_ref<reg_type> ref() { return std::atomic_ref<reg_type>{_value}; }
+
+  public:
+
+  /**
+   * @brief Default constructor with initialization
+   *
+   */
+  explicit AtomicRegister() : _value() {}
+
+  /**
+   * @brief Tagged constructor without initialization, to be used with
+   * placement new onto shared memory
+   *
+   */
+  explicit AtomicRegister(noInit) {}
+
+  using base::read;
+  using base::set;
+  using base::clear;
+  using base::toggle;
+  using base::test;
+
+  reg_type load(std::memory_order order = std::memory_order_seq_cst) {
+    return ref().load(order);
+  }
+
+  void store(reg_type value,
+             std::memory_order order = std::memory_order_seq_cst) {
+    ref().store(value, order);
+  }
+
+  /**
+   * @brief read a field with the given memory order
+   *
+   */
+  template <typename TField>
+    requires std::same_as<reg, typename TField::reg>
+  typename TField::value_type read(std::memory_order order) {
+    static_assert(details::is_readable<typename TField::access>,
+                  "field is not readable");
+    const auto value = TField::extract(static_cast<word_type>(load(order)));
+    this->template trace<TField>(trace_op::read, 0, value);
+    return value;
+  }
+
+  /**
+   * @brief set all bits of a field, one fetch_or
+   *
+   * @return previous value of the field
+   */
+  template <typename TField>
+    requires std::same_as<reg, typename TField::reg>
+  typename TField::value_type
+  set(std::memory_order order = std::memory_order_seq_cst) {
+    static_assert(details::is_writeable<typename TField::access>,
+                  "field is not writeable");
+    const auto previous = static_cast<word_type>(
+        ref().fetch_or(static_cast<reg_type>(TField::word_mask), order));
+    traced_write<TField>(previous | TField::word_mask);
+    return TField::extract(previous);
+  }
+
+  /**
+   * @brief clear all bits of a field, one fetch_and
+   *
+   * @return previous value of the field
+   */
+  template <typename TField>
+    requires std::same_as<reg, typename TField::reg>
+  typename TField::value_type
+  clear(std::memory_order order = std::memory_order_seq_cst) {
+    static_assert(details::is_writeable<typename TField::access>,
+                  "field is not writeable");
+    const auto previous = static_cast<word_type>(
+        ref().fetch_and(static_cast<reg_type>(~TField::word_mask), order));
+    traced_write<TField>(previous & ~TField::word_mask);
+    return TField::extract(previous);
+  }
+
+  /**
+   * @brief invert all bits of a field, one fetch_xor
+   *
+   * @return previous value of the field
+   */
+  template <typename TField>
+    requires std::same_as<reg, typename TField::reg>
+  typename TField::value_type
+  toggle(std::memory_order order = std::memory_order_seq_cst) {
+    static_assert(details::is_writeable<typename TField::access>,
+                  "field is not writeable");
+    const auto previous = static_cast<word_type>(
+        ref().fetch_xor(static_cast<reg_type>(TField::word_mask), order));
+    traced_write<TField>(previous ^ TField::word_mask);
+    return TField::extract(previous);
+  }
+
+  /**
+   * @brief replace the word by f(word) with a compare-exchange loop, used by
+   * all field writes of RegisterBase
+   *
+   * @return word before the update
+   */
+  template <typename F> reg_type modify_word(F &&f) {
+    auto atomic = ref();
+    auto expected = atomic.load(std::memory_order_relaxed);
+
+    while (!atomic.compare_exchange_weak(
+        expected,
+        static_cast<reg_type>(f(static_cast<word_type>(expected))),
+        std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    }
+
+    return expected;
+  }
+
+ private:
+
+  /**
+   * @brief trace the field value a set/clear/toggle left in word
+   *
+   */
+  template <typename TField> void traced_write([[maybe_unused]] auto word) {
+    if constexpr (base::traced) {
+      this->template trace<TField>(
+          trace_op::write, 0, TField::extract(static_cast<word_type>(word)));
+    }
+  }
+};
+
+} // namespace regs
@@ -11,10 +11,14 @@
 
 #pragma once
 
+#include <bit>
+#include <concepts>
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
 #include <limits>
 #include <span>
+#include <type_traits>
 #include <utility>
 
 #include "Utility.h"
@@ -118,79 +122,246 @@ constexpr auto to_byte_array(std::span<const std::byte> const src) noexcept {
     return result;
 }
 
-template <std::size_t Size, class IntegerType, std::size_t ToSize = Size>
-constexpr byte_array<ToSize> array_shift_right(const byte_array<Size>& src,
-                                             IntegerType shift) noexcept {
-    byte_array<Size> result = src;
-    byte_array<ToSize> out;
+/**
+ * @brief smallest native unsigned integer covering Bytes bytes
+ *
+ * Resolves to void if no native integer is wide enough, in which case the
+ * multi-word routines have to be used.
+ *
+ * @tparam Bytes
+ */
+template <std::size_t Bytes>
+using uint_for_bytes_t = std::conditional_t<
+    Bytes <= 1, std::uint8_t,
+    std::conditional_t<
+        Bytes <= 2, std::uint16_t,
+        std::conditional_t<Bytes <= 4, std::uint32_t,
+                           std::conditional_t<Bytes <= 8, std::uint64_t,
+                                              void>>>>;
+
+/**
+ * @brief assemble a word from Count bytes, byte 0 being the least significant
+ *
+ * Outside of constant evaluation a little endian host copies the bytes
+ * straight into the word, which compiles to a single load.
+ *
+ * @tparam Word
+ * @tparam Count
+ * @param src
+ * @return constexpr Word
+ */
+template <typename Word, std::size_t Count = sizeof(Word)>
+constexpr Word load_word(const std::byte *src) noexcept {
+  static_assert(Count <= sizeof(Word), "word too small");
+  Word result{0};
+  if constexpr (std::endian::native == std::endian::little) {
+    if (!std::is_constant_evaluated()) {
+      std::memcpy(&result, src, Count);
+      return result;
+    }
+  }
+  for (std::size_t i = 0; i < Count; i++) {
+    result |= static_cast<Word>(static_cast<Word>(src[i]) << (8 * i));
+  }
+  return result;
+}
+
+/**
+ * @brief store the lower Count bytes of a word, byte 0 being the least
+ * significant
+ *
+ * @tparam Count
+ * @tparam Word
+ * @param dst
+ * @param value
+ */
+template <std::size_t Count, typename Word>
+constexpr void store_word(std::byte *dst, Word value) noexcept {
+  static_assert(Count <= sizeof(Word), "word too small");
+  if constexpr (std::endian::native == std::endian::little) {
+    if (!std::is_constant_evaluated()) {
+      std::memcpy(dst, &value, Count);
+      return;
+    }
+  }
+  for (std::size_t i = 0; i < Count; i++) {
+    dst[i] = static_cast<std::byte>(value >> (8 * i));
+  }
+}
+
+/**
+ * @brief reverse the bytes of a word, std::byteswap before C++23
+ *
+ * @tparam Word
+ * @param value
+ * @return constexpr Word
+ */
+template <std::unsigned_integral Word>
+constexpr Word byteswap(Word value) noexcept {
+  if constexpr (sizeof(Word) == 1) {
+    return value;
+  } else {
+#if defined(__GNUC__) || defined(__clang__)
+    if constexpr (sizeof(Word) == 2) {
+      return __builtin_bswap16(value);
+    } else if constexpr (sizeof(Word) == 4) {
+      return __builtin_bswap32(value);
+    } else if constexpr (sizeof(Word) == 8) {
+      return __builtin_bswap64(value);
+    }
+#endif
+    Word result{0};
+    for (std::size_t i = 0; i < sizeof(Word); i++) {
+      result = static_cast<Word>((result << 8) | ((value >> (8 * i)) & 0xFF));
+    }
+    return result;
+  }
+}
 
-    // std::cout << "shift: " << shift << ", size: " << Size << std::endl;
+namespace details {
 
-    bool carry[Size];
+using limb_type = std::uint64_t;
 
-    for (IntegerType i = 0; i < shift; i++) {
-        // std::cout << "iteration i: " << i << std::endl;
+inline constexpr std::size_t limb_bits = 8 * sizeof(limb_type);
 
-        for (int j = (int)Size - 1; j >= 0; j--) {
-            // std::cout << "iteration j: " << j << std::endl;
+template <std::size_t Size>
+inline constexpr std::size_t limb_count = (Size + sizeof(limb_type) - 1) /
+                                          sizeof(limb_type);
+
+/**
+ * @brief split a byte_array into 64 bit limbs, limb 0 being the least
+ * significant
+ *
+ */
+template <std::size_t Size>
+constexpr void load_limbs(const byte_array<Size> &src,
+                          limb_type (&limbs)[limb_count<Size>]) noexcept {
+  for (std::size_t i = 0; i < limb_count<Size>; i++) {
+    limbs[i] = 0;
+  }
+  for (std::size_t i = 0; i < Size; i++) {
+    limbs[i / sizeof(limb_type)] |= static_cast<limb_type>(src[i])
+                                    << (8 * (i % sizeof(limb_type)));
+  }
+}
 
-            auto shifted = shift_right(result[j]);
+template <std::size_t Size, std::size_t ToSize>
+constexpr void store_limbs(const limb_type (&limbs)[limb_count<Size>],
+                           byte_array<ToSize> &dst) noexcept {
+  for (std::size_t i = 0; i < ToSize; i++) {
+    dst[i] = i < Size ? static_cast<std::byte>(
+                            limbs[i / sizeof(limb_type)] >>
+                            (8 * (i % sizeof(limb_type))))
+                      : std::byte{0};
+  }
+}
+
+} // namespace details
+
+/**
+ * @brief shift a byte_array right, byte 0 being the least significant
+ *
+ * Arrays of up to 8 bytes are shifted as one native word, wider arrays as
+ * 64 bit limbs with carries. The result is truncated or zero extended to
+ * ToSize bytes.
+ *
+ * @tparam Size
+ * @tparam IntegerType
+ * @tparam ToSize
+ * @param src
+ * @param shift
+ * @return constexpr byte_array<ToSize>
+ */
+template <std::size_t Size, class IntegerType, std::size_t ToSize = Size>
+constexpr byte_array<ToSize> array_shift_right(const byte_array<Size>& src,
+                                             IntegerType shift) noexcept {
+  byte_array<ToSize> out;
+  const auto count = static_cast<std::size_t>(shift);
 
-            carry[j] = shifted.second;
-            // std::cout << "byte[" << j << "] = 0x" << std::hex <<
-            // shifted.first << " carry "
-            //           << carry[j] << std::endl;
+  if constexpr (Size <= sizeof(details::limb_type)) {
+    using word_type = uint_for_bytes_t<Size>;
 
-            if (j < ((int)Size) - 1) {
-                if (carry[j + 1]) {
-                    shifted.first |= std::byte{0x80};
-                }
-            }
-            result[j] = shifted.first;
+    auto word = load_word<word_type, Size>(src.data());
+    word = count < Size * 8 ? static_cast<word_type>(word >> count)
+                            : word_type{0};
 
-            // std::cout << "result[" << j << "] = 0x" << std::hex <<
-            // shifted.first << " carry "
-            //           << carry[j] << std::endl;
-        }
+    constexpr auto stored = ToSize < Size ? ToSize : Size;
+    store_word<stored>(out.data(), word);
+    for (std::size_t i = stored; i < ToSize; i++) {
+      out[i] = std::byte{0};
+    }
+  } else {
+    constexpr auto limbs = details::limb_count<Size>;
+
+    details::limb_type words[limbs];
+    details::limb_type result[limbs];
+    details::load_limbs(src, words);
+
+    const auto word_shift = count / details::limb_bits;
+    const auto bit_shift = count % details::limb_bits;
+
+    for (std::size_t i = 0; i < limbs; i++) {
+      auto lo = i + word_shift < limbs ? words[i + word_shift] : 0;
+      auto hi = i + word_shift + 1 < limbs ? words[i + word_shift + 1] : 0;
+      result[i] = bit_shift ? (lo >> bit_shift) |
+                                  (hi << (details::limb_bits - bit_shift))
+                            : lo;
     }
-    std::copy(result.begin(), result.begin() + ToSize, out.begin());
 
-    return out;
+    details::store_limbs<Size>(result, out);
+  }
+
+  return out;
 }
 
+/**
+ * @brief shift a byte_array left, byte 0 being the least significant
+ *
+ * Same strategy as array_shift_right, bits shifted out of the last byte are
+ * dropped.
+ *
+ * @tparam Size
+ * @tparam IntegerType
+ * @param src
+ * @param shift
+ * @return constexpr byte_array<Size>
+ */
 template <std::size_t Size, class IntegerType>
 constexpr byte_array<Size> array_shift_left(const byte_array<Size>& src,
                                             IntegerType shift) noexcept {
-    byte_array<Size> result = src;
-
-    // std::cout << "shift: " << shift << ", size: " << Size << std::endl;
+  byte_array<Size> out;
+  const auto count = static_cast<std::size_t>(shift);
 
-    bool carry[Size];
+  if constexpr (Size <= sizeof(details::limb_type)) {
+    using word_type = uint_for_bytes_t<Size>;
 
-    for (IntegerType i = 0; i < shift; i++) {
-        // std::cout << "iteration i: " << i << std::endl;
+    auto word = load_word<word_type, Size>(src.data());
+    word = count < Size * 8 ? static_cast<word_type>(word << count)
+                            : word_type{0};
 
-        for (unsigned j = 0; j < Size; j++) {
-            // std::cout << "iteration j: " << j << std::endl;
+    store_word<Size>(out.data(), word);
+  } else {
+    constexpr auto limbs = details::limb_count<Size>;
 
-            auto shifted = shift_left(result[j]);
-            carry[j] = shifted.second;
+    details::limb_type words[limbs];
+    details::limb_type result[limbs];
+    details::load_limbs(src, words);
 
-            if (j > 0) {
-                if (carry[j - 1]) {
-                    shifted.first |= std::byte{0x01};
-                }
-            }
+    const auto word_shift = count / details::limb_bits;
+    const auto bit_shift = count % details::limb_bits;
 
-            result[j] = shifted.first;
-
-            // std::cout << "result[" << j << "] = 0x" << std::hex <<
-            // shifted.first << " carry "
-            //           << carry[j] << std::endl;
-        }
+    for (std::size_t i = 0; i < limbs; i++) {
+      auto hi = i >= word_shift ? words[i - word_shift] : 0;
+      auto lo = i >= word_shift + 1 ? words[i - word_shift - 1] : 0;
+      result[i] = bit_shift ? (hi << bit_shift) |
+                                  (lo >> (details::limb_bits - bit_shift))
+                            : hi;
     }
 
-    return result;
+    details::store_limbs<Size>(result, out);
+  }
+
+  return out;
 }
 
 constexpr std::byte operator""_b(unsigned long long int value) noexcept {
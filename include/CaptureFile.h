@@ -0,0 +1,313 @@
+#pragma once
+
+#include "RegisterPack.h"
+#include <cerrno>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace regs {
+
+/**
+ * @brief One frame of a capture file, the bytes stay in the mapping
+ *
+ * @tparam HeaderPack RegisterPack of the frame header
+ */
+template <typename HeaderPack> struct CaptureFrame {
+  static constexpr std::size_t header_size =
+      sizeof(typename HeaderPack::target_type);
+
+  std::span<std::byte> bytes;
+
+  std::size_t size() const { return bytes.size(); }
+
+  /**
+   * @brief bytes behind the header
+   *
+   */
+  std::span<std::byte> payload() const { return bytes.subspan(header_size); }
+
+  /**
+   * @brief view of the frame header in the mapping
+   *
+   */
+  PackView<HeaderPack> header() const { return overlay<HeaderPack>(); }
+
+  /**
+   * @brief view of a RegisterPack over the frame bytes starting at offset,
+   * no copy is made
+   *
+   * @tparam Pack RegisterPack, const for a read-only view
+   */
+  template <typename Pack>
+  PackView<Pack> overlay(std::size_t offset = 0) const {
+    constexpr auto pack_size = PackView<Pack>::pack_size;
+    ESCAD_ASSERT(offset + pack_size <= bytes.size(), "pack exceeds frame");
+    return PackView<Pack>{bytes.subspan(offset).template first<pack_size>()};
+  }
+
+  /**
+   * @brief a PackView over the frame bytes starting at offset
+   *
+   * @tparam Pack RegisterPack
+   */
+  template <typename Pack>
+  PackView<Pack, std::dynamic_extent> view(std::size_t offset = 0) const {
+    return PackView<Pack, std::dynamic_extent>{bytes.subspan(offset)};
+  }
+
+  /**
+   * @brief read a PackedRegister of a pack starting at pack_offset
+   *
+   */
+  template <typename Reg>
+  typename Reg::reg_type decode(std::size_t pack_offset = 0) const {
+    return Reg::decode(bytes.subspan(pack_offset));
+  }
+};
+
+/**
+ * @brief Memory mapped file of recorded frames
+ *
+ * open() maps the whole file and indexes the frames with one sequential scan
+ * over the total length of each frame header. The index stops at the first
+ * frame that is shorter than its header or runs past the end of the file,
+ * the remaining bytes are reported by trailing().
+ *
+ * The mapping is private and writeable: registers of PackViews over the
+ * frames are used as usual, writes never reach the file.
+ *
+ * @tparam HeaderPack RegisterPack of the frame header
+ * @tparam TotalLengthReg PackedRegister of HeaderPack holding the total frame
+ * length in bytes, header included
+ */
+template <typename HeaderPack, typename TotalLengthReg> class CaptureFile {
+ public:
+
+ using frame = CaptureFrame<HeaderPack>;
+
+ static constexpr std::size_t header_size = frame::header_size;
+
+ private:
+
+ std::byte *_data = nullptr;
+ std::size_t _size = 0;
+
+ // offset of each frame, followed by the end of the last frame
+ std::vector<std::size_t> _offsets;
+
+ CaptureFile(std::byte *data, std::size_t size) : _data(data), _size(size) {
+   index();
+ }
+
+  public:
+
+  class iterator {
+   public:
+
+   using value_type = frame;
+   using difference_type = std::ptrdiff_t;
+   using iterator_category = std::input_iterator_tag;
+
+   iterator() = default;
+
+   iterator(const CaptureFile *file, std::size_t index)
+       : _file(file), _index(index) {}
+
+   frame operator*() const { return (*_file)[_index]; }
+
+   iterator &operator++() {
+     ++_index;
+     return *this;
+   }
+
+   iterator operator++(int) {
+     auto previous = *this;
+     ++_index;
+     return previous;
+   }
+
+   bool operator==(const iterator &other) const {
+     return _index == other._index;
+   }
+
+   private:
+
+   const CaptureFile *_file = nullptr;
+   std::size_t _index = 0;
+  };
+
+  /**
+   * @brief map and index a capture file
+   *
+   * @return std::optional<CaptureFile> nothing if the file cannot be opened or
+   * mapped, errno tells why
+   */
+  static std::optional<CaptureFile> open(const char *path) {
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+      return std::nullopt;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+      const int error = errno;
+      ::close(fd);
+      errno = error;
+      return std::nullopt;
+    }
+
+    const auto size = static_cast<std::size_t>(info.st_size);
+    void *data = nullptr;
+
+    if (size > 0) {
+      data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+
+    const int error = errno;
+    ::close(fd);
+
+    if (data == MAP_FAILED) {
+      errno = error;
+      return std::nullopt;
+    }
+
+    if (size > 0) {
+      // the index scan and most replays run front to back
+      ::madvise(data, size, MADV_SEQUENTIAL);
+      ::madvise(data, size, MADV_WILLNEED);
+    }
+
+    return CaptureFile{static_cast<std::byte *>(data), size};
+  }
+
+  CaptureFile(CaptureFile &&other) noexcept
+      : _data(std::exchange(other._data, nullptr)),
+        _size(std::exchange(other._size, 0)),
+        _offsets(std::move(other._offsets)) {}
+
+  CaptureFile &operator=(CaptureFile &&other) noexcept {
+    if (this != &other) {
+      unmap();
+      _data = std::exchange(other._data, nullptr);
+      _size = std::exchange(other._size, 0);
+      _offsets = std::move(other._offsets);
+    }
+    return *this;
+  }
+
+  CaptureFile(const CaptureFile &) = delete;
+  CaptureFile &operator=(const CaptureFile &) = delete;
+
+  ~CaptureFile() { unmap(); }
+
+  /**
+   * @brief number of indexed frames
+   *
+   */
+  std::size_t size() const {
+    return _offsets.empty() ? 0 : _offsets.size() - 1;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  frame operator[](std::size_t index) const {
+    ESCAD_ASSERT(index < size(), "frame index out of range");
+    return {{_data + _offsets[index], _offsets[index + 1] - _offsets[index]}};
+  }
+
+  /**
+   * @brief byte offset of a frame within the file
+   *
+   */
+  std::size_t offset(std::size_t index) const { return _offsets[index]; }
+
+  iterator begin() const { return {this, 0}; }
+  iterator end() const { return {this, size()}; }
+
+  /**
+   * @brief bytes behind the last complete frame, a truncated or corrupt
+   * frame
+   *
+   */
+  std::size_t trailing() const {
+    return _size - (_offsets.empty() ? 0 : _offsets.back());
+  }
+
+  /**
+   * @brief the whole mapped file
+   *
+   */
+  std::span<std::byte> bytes() const { return {_data, _size}; }
+
+  /**
+   * @brief hint that frames are accessed in no particular order, turns off
+   * the read ahead requested by open()
+   *
+   */
+  void advise_random() const { advise(0, _size, MADV_RANDOM); }
+
+  /**
+   * @brief ask the kernel to read count frames starting at first ahead of
+   * time
+   *
+   */
+  void prefetch(std::size_t first, std::size_t count = 1) const {
+    ESCAD_ASSERT(first + count <= size(), "frame index out of range");
+    advise(_offsets[first], _offsets[first + count] - _offsets[first],
+           MADV_WILLNEED);
+  }
+
+ private:
+
+  void index() {
+    std::size_t position = 0;
+
+    _offsets.clear();
+    _offsets.push_back(position);
+
+    while (_size - position >= header_size) {
+      const auto length = static_cast<std::size_t>(TotalLengthReg::decode(
+          std::span<const std::byte>{_data + position, header_size}));
+
+      if (length < header_size || length > _size - position) {
+        break;
+      }
+
+      position += length;
+      _offsets.push_back(position);
+    }
+  }
+
+  /**
+   * @brief madvise on the pages covering [offset, offset + length)
+   *
+   */
+  void advise(std::size_t offset, std::size_t length, int advice) const {
+    if (length == 0) {
+      return;
+    }
+
+    const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const auto begin = offset / page * page;
+
+    ::madvise(_data + begin, offset + length - begin, advice);
+  }
+
+  void unmap() {
+    if (_data != nullptr) {
+      ::munmap(_data, _size);
+      _data = nullptr;
+    }
+  }
+};
+
+} // namespace regs
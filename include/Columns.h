@@ -0,0 +1,197 @@
+#pragma once
+
+#include "Fields.h"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#include <span>
+#include <type_traits>
+
+namespace regs {
+
+namespace details {
+
+/**
+ * @brief fields that are whole, distinct 32 bit words within the first 16
+ * bytes of a record, these are decoded by a 4x4 word transpose
+ *
+ */
+template <typename... TFields>
+concept is_word32_columns =
+    sizeof...(TFields) >= 1 && sizeof...(TFields) <= 4 &&
+    ((TFields::bit_offset == 0 && TFields::value_size == 4 &&
+      TFields::byte_count == 4 && TFields::byte_offset % 4 == 0 &&
+      TFields::byte_offset + 4 <= 16) &&
+     ...) &&
+    [] {
+      std::array<unsigned, sizeof...(TFields)> offsets{TFields::byte_offset...};
+      for (std::size_t i = 0; i < offsets.size(); i++) {
+        for (std::size_t j = i + 1; j < offsets.size(); j++) {
+          if (offsets[i] == offsets[j]) {
+            return false;
+          }
+        }
+      }
+      return true;
+    }();
+
+/**
+ * @brief read a field from the bytes of one record, whole byte fields are
+ * copied so non integral values like float work as well
+ *
+ */
+template <typename TField>
+inline typename TField::value_type
+read_column(std::span<const std::byte> record) {
+  using value_type = typename TField::value_type;
+
+  if constexpr (TField::bit_offset == 0 &&
+                TField::byte_count == TField::value_size) {
+    value_type value;
+    std::memcpy(&value, record.data() + TField::byte_offset, sizeof(value));
+    return value;
+  } else {
+    return TField::read(record);
+  }
+}
+
+/**
+ * @brief transpose the first four 32 bit words of count records into up to
+ * four columns, columns[j] receiving word j, null columns are skipped
+ *
+ * Records are handled in blocks of eight with AVX2 and of four with SSE2.
+ *
+ * @return number of records transposed, the rest is left to the caller
+ */
+inline std::size_t transpose_words32(const std::byte *records,
+                                     std::size_t stride, std::size_t count,
+                                     const std::array<std::byte *, 4> &columns) {
+  std::size_t i = 0;
+
+#if defined(__AVX2__)
+  for (; i + 8 <= count; i += 8) {
+    auto load = [&](std::size_t r) {
+      return _mm256_set_m128i(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+              records + (i + r + 4) * stride)),
+          _mm_loadu_si128(
+              reinterpret_cast<const __m128i *>(records + (i + r) * stride)));
+    };
+
+    auto r0 = load(0), r1 = load(1), r2 = load(2), r3 = load(3);
+
+    auto t0 = _mm256_unpacklo_epi32(r0, r1);
+    auto t1 = _mm256_unpacklo_epi32(r2, r3);
+    auto t2 = _mm256_unpackhi_epi32(r0, r1);
+    auto t3 = _mm256_unpackhi_epi32(r2, r3);
+
+    const __m256i words[4] = {
+        _mm256_unpacklo_epi64(t0, t1), _mm256_unpackhi_epi64(t0, t1),
+        _mm256_unpacklo_epi64(t2, t3), _mm256_unpackhi_epi64(t2, t3)};
+
+    for (std::size_t j = 0; j < 4; j++) {
+      if (columns[j] != nullptr) {
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i *>(columns[j] + i * 4), words[j]);
+      }
+    }
+  }
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+  for (; i + 4 <= count; i += 4) {
+    auto load = [&](std::size_t r) {
+      return _mm_loadu_si128(
+          reinterpret_cast<const __m128i *>(records + (i + r) * stride));
+    };
+
+    auto r0 = load(0), r1 = load(1), r2 = load(2), r3 = load(3);
+
+    auto t0 = _mm_unpacklo_epi32(r0, r1);
+    auto t1 = _mm_unpacklo_epi32(r2, r3);
+    auto t2 = _mm_unpackhi_epi32(r0, r1);
+    auto t3 = _mm_unpackhi_epi32(r2, r3);
+
+    const __m128i words[4] = {
+        _mm_unpacklo_epi64(t0, t1), _mm_unpackhi_epi64(t0, t1),
+        _mm_unpacklo_epi64(t2, t3), _mm_unpackhi_epi64(t2, t3)};
+
+    for (std::size_t j = 0; j < 4; j++) {
+      if (columns[j] != nullptr) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(columns[j] + i * 4),
+                         words[j]);
+      }
+    }
+  }
+#else
+  (void)records;
+  (void)stride;
+  (void)count;
+  (void)columns;
+#endif
+
+  return i;
+}
+
+/**
+ * @brief reverse the bytes of every value in place
+ *
+ * Blocks of 32 bytes are swapped with one AVX2 shuffle, blocks of 16 bytes
+ * with one SSSE3 shuffle, the rest value by value through its native word,
+ * so values of any type one word wide, e.g. enums, are swapped without
+ * aliasing them as integers.
+ *
+ */
+template <typename T>
+  requires std::is_trivially_copyable_v<T> &&
+           std::unsigned_integral<uint_for_bytes_t<sizeof(T)>> &&
+           (sizeof(uint_for_bytes_t<sizeof(T)>) == sizeof(T))
+inline void byteswap_all(std::span<T> words) {
+  using Word = uint_for_bytes_t<sizeof(T)>;
+  std::size_t i = 0;
+
+  if constexpr (sizeof(Word) > 1) {
+    [[maybe_unused]] auto *bytes = reinterpret_cast<std::byte *>(words.data());
+    [[maybe_unused]] constexpr std::size_t per_block = 16 / sizeof(Word);
+
+#if defined(__SSSE3__)
+    alignas(16) std::uint8_t order[16];
+    for (std::size_t b = 0; b < 16; b++) {
+      order[b] = static_cast<std::uint8_t>((b / sizeof(Word)) * sizeof(Word) +
+                                           sizeof(Word) - 1 - b % sizeof(Word));
+    }
+    const auto shuffle =
+        _mm_load_si128(reinterpret_cast<const __m128i *>(order));
+
+#if defined(__AVX2__)
+    const auto shuffle2 = _mm256_broadcastsi128_si256(shuffle);
+
+    for (; i + 2 * per_block <= words.size(); i += 2 * per_block) {
+      auto *block = reinterpret_cast<__m256i *>(bytes + i * sizeof(Word));
+      _mm256_storeu_si256(
+          block, _mm256_shuffle_epi8(_mm256_loadu_si256(block), shuffle2));
+    }
+#endif
+
+    for (; i + per_block <= words.size(); i += per_block) {
+      auto *block = reinterpret_cast<__m128i *>(bytes + i * sizeof(Word));
+      _mm_storeu_si128(block,
+                       _mm_shuffle_epi8(_mm_loadu_si128(block), shuffle));
+    }
+#endif
+
+    for (; i < words.size(); i++) {
+      words[i] = std::bit_cast<T>(byteswap(std::bit_cast<Word>(words[i])));
+    }
+  }
+}
+
+} // namespace details
+
+} // namespace regs
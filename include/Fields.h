@@ -14,6 +14,7 @@
 #include "Bytes.h"
 #include <bit>
 #include <span>
+#include <type_traits>
 
 namespace regs {
 
@@ -38,6 +39,94 @@ concept is_writeonly = std::is_same_v<T, write_only>;
 template <unsigned bit_offset, unsigned width>
 concept is_trivially_accessible = bit_offset == 0 && (width % 8) == 0;
 
+template <typename T>
+concept is_field_value = requires {
+  typename T::field;
+  T::value;
+};
+
+/**
+ * @brief placeholder for masks of registers without native word
+ *
+ */
+struct no_word {};
+
+/**
+ * @brief mask of width bits starting at bit shift within Word
+ *
+ * @tparam Word
+ * @param shift
+ * @param width
+ * @return constexpr auto
+ */
+template <typename Word>
+constexpr auto make_word_mask(unsigned shift, unsigned width) noexcept {
+  if constexpr (std::is_void_v<Word>) {
+    return no_word{};
+  } else {
+    constexpr unsigned bits = sizeof(Word) * 8;
+
+    if (shift >= bits) {
+      return Word{0};
+    }
+
+    auto ones = width >= bits ? static_cast<Word>(~Word{0})
+                              : static_cast<Word>((Word{1} << width) - 1);
+
+    return static_cast<Word>(ones << shift);
+  }
+}
+
+/**
+ * @brief mask of width bits starting at bit shift over Size bytes
+ *
+ * @tparam Size
+ * @param shift
+ * @param width
+ * @return constexpr byte_array<Size>
+ */
+template <std::size_t Size>
+constexpr byte_array<Size> make_mask_bytes(unsigned shift,
+                                           unsigned width) noexcept {
+  byte_array<Size> result;
+
+  for (unsigned i = 0; i < Size; i++) {
+    unsigned first = shift > i * 8 ? shift : i * 8;
+    unsigned last = shift + width < i * 8 + 8 ? shift + width : i * 8 + 8;
+
+    result[i] = first < last ? std::byte{static_cast<std::uint8_t>(
+                                   ((1u << (last - first)) - 1)
+                                   << (first - i * 8))}
+                             : std::byte{0x00};
+  }
+
+  return result;
+}
+
+/**
+ * @brief raw bits of a field value
+ *
+ */
+template <typename Word, typename Value>
+constexpr Word to_bits(Value value) noexcept {
+  if constexpr (std::is_enum_v<Value>) {
+    return static_cast<Word>(
+        static_cast<std::make_unsigned_t<std::underlying_type_t<Value>>>(
+            value));
+  } else {
+    return static_cast<Word>(value);
+  }
+}
+
+/**
+ * @brief field value from raw bits
+ *
+ */
+template <typename Value, typename Word>
+constexpr Value from_bits(Word bits) noexcept {
+  return static_cast<Value>(bits);
+}
+
 } // namespace details
 
 /**
@@ -45,10 +134,12 @@ concept is_trivially_accessible = bit_offset == 0 && (width % 8) == 0;
  *
  * @tparam offset offset to the first bit
  * @tparam width bit width of the field
+ * @tparam reset value of the field after reset
  */
 template <typename Reg, unsigned offset, unsigned width,
           unsigned start_byte = 0, typename Access = read_write,
-          typename Value_type = typename Reg::reg_type>
+          typename Value_type = typename Reg::reg_type,
+          Value_type reset = Value_type{}>
 struct Field {
   using reg = Reg;
   // using reg_type = typename Reg::reg_type;
@@ -62,7 +153,7 @@ struct Field {
   using target_type = typename Reg::target_type;
 
   static_assert(width >= 1, "invalid width");
-  static_assert(offset + width <= sizeof(target_type) * 8,
+  static_assert(start_byte * 8 + offset + width <= sizeof(target_type) * 8,
                 "invalid width/offset");
 
   // byte_offset
@@ -74,78 +165,98 @@ struct Field {
 
   static constexpr unsigned count_mask_bytes = sizeof(target_type);
 
-  static constexpr auto maskBytes() {
-    byte_array<count_mask_bytes> _maskBytes;
-
-    int offset_ = bit_offset;
-    int width_ = width;
-
-    int bytes_masked = 0;
-
-    for (unsigned i = 0; i < count_mask_bytes; i++) {
-      if (i >= byte_offset) {
-        uint8_t mask_ = ((1 << width_) - 1) << offset_;
-
-        _maskBytes[i] = std::byte{mask_};
-
-        bytes_masked++;
-
-        // clear the offset and shrink size for a second byte
-        offset_ = 0;
-        width_ = bit_offset + width - (bytes_masked * 8);
-        if (width_ <= 0) {
-          width_ = 0;
-        }
-
-      } else {
-        _maskBytes[i] = std::byte{0x00};
-      }
-    }
-
-    return _maskBytes;
+  // bit position of the field within the register
+  static constexpr unsigned shift = start_byte * 8 + offset;
+
+  // number of bits of the field
+  static constexpr unsigned field_width = width;
+
+  // value of the field after reset, combined by FieldMap
+  static constexpr value_type reset_value = reset;
+
+  // native word covering the whole register, void if there is none
+  using word_type = uint_for_bytes_t<count_mask_bytes>;
+
+  // native word covering the bytes the field touches, void if there is none
+  using window_type = uint_for_bytes_t<byte_count>;
+
+  // mask of the field over all bytes of the register
+  static constexpr byte_array<count_mask_bytes> mask =
+      details::make_mask_bytes<count_mask_bytes>(shift, width);
+
+  // mask of the field within word_type
+  static constexpr auto word_mask =
+      details::make_word_mask<word_type>(shift, width);
+
+  // mask of the field within window_type, relative to byte_offset
+  static constexpr auto window_mask =
+      details::make_word_mask<window_type>(bit_offset, width);
+
+  static constexpr auto maskBytes() { return mask; }
+
+  /**
+   * @brief compile-time value of the field, used for batched writes
+   *
+   * @tparam v
+   */
+  template <value_type v> struct Value {
+    using field = Field;
+    static constexpr value_type value = v;
+  };
+
+  /**
+   * @brief extract the field from the register as native word
+   *
+   * @param word
+   * @return constexpr value_type
+   */
+  template <typename Word = word_type>
+    requires(!std::is_void_v<Word>)
+  static constexpr value_type extract(Word word) noexcept {
+    return details::from_bits<value_type>(
+        static_cast<Word>(word & word_mask) >> shift);
   }
 
-  static constexpr auto read_masked(std::span<const std::byte> const target)
-    requires std::integral<value_type>
-  {
-    value_type result;
-
-    byte_array<count_mask_bytes> Bytes;
-
-    auto mask = maskBytes();
-
-    for (unsigned i = 0; i < count_mask_bytes; i++) {
-      // Bytes[i] = target[byte_offset + i] & mask[i];
-      Bytes[i] = target[i] & mask[i];
-    }
-
-    auto shifted = array_shift_right<count_mask_bytes, unsigned, value_size>(
-        Bytes, offset);
-
-    result = std::bit_cast<value_type>(shifted);
-
-    return result;
+  /**
+   * @brief insert the field into the register as native word
+   *
+   * @param word
+   * @param value
+   * @return constexpr Word
+   */
+  template <typename Word = word_type>
+    requires(!std::is_void_v<Word>)
+  static constexpr Word insert(Word word, value_type value) noexcept {
+    return static_cast<Word>(
+        (word & static_cast<Word>(~word_mask)) |
+        (static_cast<Word>(details::to_bits<Word>(value) << shift) &
+         word_mask));
   }
 
   static constexpr auto read_masked(std::span<const std::byte> const target)
-    requires std::is_enum_v<value_type>
+    requires std::integral<value_type> || std::is_enum_v<value_type>
   {
-    // value_type result;
-
-    byte_array<count_mask_bytes> Bytes;
+    if constexpr (!std::is_void_v<word_type>) {
+      return extract(load_word<word_type, count_mask_bytes>(target.data()));
+    } else if constexpr (!std::is_void_v<window_type>) {
+      auto window =
+          load_word<window_type, byte_count>(target.data() + byte_offset);
+      return details::from_bits<value_type>(
+          static_cast<window_type>(window & window_mask) >> bit_offset);
+    } else {
+      byte_array<count_mask_bytes> Bytes;
+
+      for (unsigned i = 0; i < count_mask_bytes; i++) {
+        Bytes[i] = target[i] & mask[i];
+      }
 
-    auto mask = maskBytes();
+      auto shifted =
+          array_shift_right<count_mask_bytes, unsigned, sizeof(std::uint64_t)>(
+              Bytes, shift);
 
-    for (unsigned i = 0; i < count_mask_bytes; i++) {
-      // Bytes[i] = target[byte_offset + i] & mask[i];
-      Bytes[i] = target[i] & mask[i];
+      return details::from_bits<value_type>(
+          load_word<std::uint64_t>(shifted.data()));
     }
-
-    auto shifted = array_shift_right(Bytes, offset);
-
-    auto number = std::bit_cast<std::underlying_type_t<value_type>>(shifted);
-
-    return value_type{number};
   }
 
   static constexpr auto read_trivial(std::span<const std::byte> const target)
@@ -153,10 +264,17 @@ struct Field {
   {
     value_type result;
 
-    auto Bytes = to_byte_array<byte_count>(target.subspan(byte_offset, byte_count));
-    //auto Bytes = to_byte_array<byte_count>(target);
+    if constexpr (value_size != byte_count) {
+      // value type wider or narrower than the field
+      result = static_cast<value_type>(
+          load_word<uint_for_bytes_t<byte_count>, byte_count>(target.data() +
+                                                              byte_offset));
+    } else {
+      auto Bytes = to_byte_array<byte_count>(target.subspan(byte_offset, byte_count));
+      //auto Bytes = to_byte_array<byte_count>(target);
 
-    result = std::bit_cast<value_type>(Bytes);
+      result = std::bit_cast<value_type>(Bytes);
+    }
 
     return result;
   }
@@ -165,57 +283,39 @@ struct Field {
     requires std::is_enum_v<value_type>
   {
     auto number = std::bit_cast<std::underlying_type_t<value_type>>(
-        target.subspan(byte_offset, byte_count));
+        to_byte_array<byte_count>(target.subspan(byte_offset, byte_count)));
 
     return value_type{number};
   }
 
   static constexpr void write_masked(std::span<std::byte> target,
                                      value_type value)
-    requires std::integral<value_type>
-  {
-    using ValueArray = byte_array<value_size>;
-
-    ValueArray values;
-
-    values = std::bit_cast<ValueArray>(value);
-
-    byte_array<count_mask_bytes> value_bytes;
-
-    std::copy(values.begin(), values.begin() + value_size, value_bytes.begin());
-
-    auto shifted = array_shift_left(value_bytes, offset);
-
-    auto mask = maskBytes();
-
-    for (unsigned i = 0; i < count_mask_bytes; i++) {
-      target[i] = (target[i] & ~mask[i]) | (shifted[i] & mask[i]);
-    }
-
-    return;
-  }
-
-  static constexpr void write_masked(std::span<std::byte> target,
-                                     value_type value)
-    requires std::is_enum_v<value_type>
+    requires std::integral<value_type> || std::is_enum_v<value_type>
   {
-    using ValueArray = byte_array<count_mask_bytes>;
-
-    ValueArray value_bytes;
-
-    auto number = std::bit_cast<std::underlying_type_t<value_type>>(value);
-
-    value_bytes = std::bit_cast<ValueArray>(number);
-
-    auto shifted = array_shift_left(value_bytes, offset);
-
-    auto mask = maskBytes();
-
-    for (unsigned i = 0; i < count_mask_bytes; i++) {
-      target[i] = (target[i] & ~mask[i]) | (shifted[i] & mask[i]);
+    if constexpr (!std::is_void_v<word_type>) {
+      auto word = load_word<word_type, count_mask_bytes>(target.data());
+      store_word<count_mask_bytes>(target.data(), insert(word, value));
+    } else if constexpr (!std::is_void_v<window_type>) {
+      auto window =
+          load_word<window_type, byte_count>(target.data() + byte_offset);
+      window = static_cast<window_type>(
+          (window & static_cast<window_type>(~window_mask)) |
+          (static_cast<window_type>(details::to_bits<window_type>(value)
+                                    << bit_offset) &
+           window_mask));
+      store_word<byte_count>(target.data() + byte_offset, window);
+    } else {
+      byte_array<count_mask_bytes> value_bytes{};
+
+      store_word<sizeof(std::uint64_t)>(
+          value_bytes.data(), details::to_bits<std::uint64_t>(value));
+
+      auto shifted = array_shift_left(value_bytes, shift);
+
+      for (unsigned i = 0; i < count_mask_bytes; i++) {
+        target[i] = (target[i] & ~mask[i]) | (shifted[i] & mask[i]);
+      }
     }
-
-    return;
   }
 
   static constexpr void write_trivial(std::span<std::byte> target,
@@ -224,13 +324,20 @@ struct Field {
   {
     using ValueArray = byte_array<byte_count>;
 
-    ValueArray values;
+    if constexpr (value_size != byte_count) {
+      // value type wider or narrower than the field
+      store_word<byte_count>(
+          target.data() + byte_offset,
+          static_cast<uint_for_bytes_t<byte_count>>(value));
+    } else {
+      ValueArray values;
 
-    values = std::bit_cast<ValueArray>(value);
+      values = std::bit_cast<ValueArray>(value);
 
-    auto sub_target = target.subspan(byte_offset, byte_count);
+      auto sub_target = target.subspan(byte_offset, byte_count);
 
-    std::copy(values.begin(), values.begin() + byte_count, sub_target.begin());
+      std::copy(values.begin(), values.begin() + byte_count, sub_target.begin());
+    }
 
     return;
   }
@@ -253,7 +360,7 @@ struct Field {
     return;
   }
 
-  static inline value_type
+  static constexpr value_type
   read(std::span<const std::byte> const target) noexcept
     requires details::is_readable<access> &&
              (!details::is_trivially_accessible<bit_offset, width>)
@@ -261,7 +368,7 @@ struct Field {
     return read_masked(target);
   }
 
-  static inline value_type
+  static constexpr value_type
   read(std::span<const std::byte> const target) noexcept
     requires details::is_readable<access> &&
              details::is_trivially_accessible<bit_offset, width>
@@ -269,7 +376,7 @@ struct Field {
     return read_trivial(target);
   }
 
-  static inline void write(std::span<std::byte> target,
+  static constexpr void write(std::span<std::byte> target,
                            value_type value) noexcept
     requires details::is_writeable<access> &&
              (!details::is_trivially_accessible<bit_offset, width>)
@@ -277,7 +384,7 @@ struct Field {
     write_masked(target, value);
   }
 
-    static inline void write(std::span<std::byte> target,
+    static constexpr void write(std::span<std::byte> target,
                            value_type value) noexcept
     requires details::is_writeable<access> &&
              details::is_trivially_accessible<bit_offset, width>
@@ -286,7 +393,7 @@ struct Field {
   }
 
   template <value_type value>
-  static inline void write_constant(std::span<std::byte> target) noexcept
+  static constexpr void write_constant(std::span<std::byte> target) noexcept
     requires details::is_writeable<access> &&
              (!details::is_trivially_accessible<bit_offset, width>)
   {
@@ -294,7 +401,7 @@ struct Field {
   }
 
   template <value_type value>
-  static inline void write_constant(std::span<std::byte> target) noexcept
+  static constexpr void write_constant(std::span<std::byte> target) noexcept
     requires details::is_writeable<access> &&
              details::is_trivially_accessible<bit_offset, width>
   {
@@ -302,7 +409,7 @@ struct Field {
   }
 
   template <value_type value>
-  static inline bool is(std::span<const std::byte> const target) noexcept
+  static constexpr bool is(std::span<const std::byte> const target) noexcept
     requires details::is_readable<access>  &&
              (!details::is_trivially_accessible<bit_offset, width>)
   {
@@ -310,11 +417,77 @@ struct Field {
   }
 
     template <value_type value>
-  static inline bool is(std::span<const std::byte> const target) noexcept
+  static constexpr bool is(std::span<const std::byte> const target) noexcept
     requires details::is_readable<access>  &&
              details::is_trivially_accessible<bit_offset, width>
   {
     return read_trivial(target) == value;
   }
+
+  /**
+   * @brief set all bits of the field in place
+   *
+   * Only the bytes of the field are touched, a single bit field is one OR on
+   * its byte.
+   *
+   */
+  static constexpr void set(std::span<std::byte> target) noexcept
+    requires details::is_writeable<access>
+  {
+    modify_bits(target, [](auto bits, auto mask) { return bits | mask; });
+  }
+
+  static constexpr void clear(std::span<std::byte> target) noexcept
+    requires details::is_writeable<access>
+  {
+    modify_bits(target, [](auto bits, auto mask) { return bits & ~mask; });
+  }
+
+  static constexpr void toggle(std::span<std::byte> target) noexcept
+    requires details::is_writeable<access>
+  {
+    modify_bits(target, [](auto bits, auto mask) { return bits ^ mask; });
+  }
+
+  /**
+   * @brief true if all bits of the field are set
+   *
+   */
+  static constexpr bool test(std::span<const std::byte> const target) noexcept
+    requires details::is_readable<access>
+  {
+    if constexpr (!std::is_void_v<window_type>) {
+      auto window =
+          load_word<window_type, byte_count>(target.data() + byte_offset);
+      return static_cast<window_type>(window & window_mask) == window_mask;
+    } else {
+      for (unsigned i = byte_offset; i < byte_offset + byte_count; i++) {
+        if ((target[i] & mask[i]) != mask[i]) {
+          return false;
+        }
+      }
+      return true;
+    }
+  }
+
+ private:
+
+  /**
+   * @brief replace the bytes of the field by f(bits, mask)
+   *
+   */
+  template <typename F>
+  static constexpr void modify_bits(std::span<std::byte> target, F &&f) {
+    if constexpr (!std::is_void_v<window_type>) {
+      auto *data = target.data() + byte_offset;
+      auto window = load_word<window_type, byte_count>(data);
+      store_word<byte_count>(data,
+                             static_cast<window_type>(f(window, window_mask)));
+    } else {
+      for (unsigned i = byte_offset; i < byte_offset + byte_count; i++) {
+        target[i] = f(target[i], mask[i]);
+      }
+    }
+  }
 };
 } // namespace regs
\ No newline at end of file
@@ -0,0 +1,295 @@
+#pragma once
+
+#include "RegisterPack.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+namespace regs {
+
+namespace details {
+
+enum class builder_kind { fixed, total_length, payload_length };
+
+} // namespace details
+
+/**
+ * @brief compile-time value of a whole PackedRegister, folded into the
+ * constant image of a FrameBuilder
+ *
+ */
+template <typename Reg, typename Reg::reg_type Value> struct Fixed {
+  static constexpr auto kind = details::builder_kind::fixed;
+  using reg = Reg;
+  static constexpr auto value = Value;
+};
+
+/**
+ * @brief PackedRegister receiving the size of the whole frame, header
+ * included
+ *
+ */
+template <typename Reg> struct TotalLength {
+  static constexpr auto kind = details::builder_kind::total_length;
+  using reg = Reg;
+};
+
+/**
+ * @brief PackedRegister receiving the size of the payload behind the header
+ *
+ */
+template <typename Reg> struct PayloadLength {
+  static constexpr auto kind = details::builder_kind::payload_length;
+  using reg = Reg;
+};
+
+namespace details {
+
+template <typename T>
+concept is_builder_tag = requires { T::kind; };
+
+template <typename T>
+concept is_builder_register = requires {
+  typename T::reg_pack;
+  T::offset;
+  T::size;
+};
+
+/**
+ * @brief field of a PackedRegister, as opposed to the register itself
+ *
+ */
+template <typename T>
+concept is_packed_field = requires {
+  T::shift;
+  typename T::value_type;
+} && is_builder_register<typename T::reg>;
+
+/**
+ * @brief item given a value at encode time
+ *
+ */
+template <typename T>
+concept is_runtime_item =
+    !is_builder_tag<T> && !is_field_value<T> &&
+    (is_packed_field<T> || is_builder_register<T>);
+
+template <typename T> struct item_register {
+  using type = T;
+};
+
+template <typename T>
+  requires is_builder_tag<T>
+struct item_register<T> {
+  using type = typename T::reg;
+};
+
+template <typename T>
+  requires is_field_value<T>
+struct item_register<T> {
+  using type = typename T::field::reg;
+};
+
+template <typename T>
+  requires is_packed_field<T> && (!is_field_value<T>)
+struct item_register<T> {
+  using type = typename T::reg;
+};
+
+/**
+ * @brief store a whole register into the bytes of a pack
+ *
+ */
+template <typename Reg>
+constexpr void put_register(std::byte *pack, typename Reg::reg_type value) {
+  const auto bytes = to_bytes<byte_order_of<Reg>()>(value);
+  std::copy(bytes.begin(), bytes.end(), pack + Reg::offset);
+}
+
+/**
+ * @brief insert a field into its register within the bytes of a pack
+ *
+ */
+template <typename TField>
+constexpr void put_field(std::byte *pack, typename TField::value_type value) {
+  using Reg = typename TField::reg;
+  using Word = typename TField::word_type;
+  static_assert(!std::is_void_v<Word>, "register is wider than a native word");
+
+  constexpr bool swap = byte_order_of<Reg>() != std::endian::native;
+
+  auto *target = pack + Reg::offset;
+  auto word = load_word<Word, Reg::size>(target);
+  if constexpr (swap) {
+    word = byteswap(word);
+  }
+
+  word = TField::insert(word, value);
+
+  if constexpr (swap) {
+    word = byteswap(word);
+  }
+  store_word<Reg::size>(target, word);
+}
+
+} // namespace details
+
+/**
+ * @brief Encoder for outbound frames of a RegisterPack header followed by a
+ * payload
+ *
+ * The items describe the header:
+ * - Fixed<Reg, value> and Field::Value<value> are folded into a constant
+ *   image of the header at compile time
+ * - TotalLength<Reg> and PayloadLength<Reg> are filled from the payload size
+ * - plain PackedRegisters and Fields take their value from encode()
+ *
+ * Encoding copies the image and stores each runtime value and length once,
+ * bytes no item covers are zero.
+ *
+ * @tparam Pack RegisterPack of the header
+ * @tparam Items header items
+ */
+template <typename Pack, typename... Items> class FrameBuilder {
+ public:
+
+ static constexpr std::size_t header_size =
+     sizeof(typename Pack::target_type);
+
+ static_assert((std::is_same_v<Pack, typename details::item_register<
+                                         Items>::type::reg_pack> &&
+                ...),
+               "item of another pack");
+
+ private:
+
+ template <typename Item>
+ static constexpr auto runtime_item() {
+   if constexpr (details::is_runtime_item<Item>) {
+     return std::tuple<std::type_identity<Item>>{};
+   } else {
+     return std::tuple<>{};
+   }
+ }
+
+  public:
+
+  /**
+   * @brief items taking a value in encode(), in the order of Items, each
+   * wrapped in std::type_identity
+   *
+   */
+  using runtime_items = decltype(std::tuple_cat(runtime_item<Items>()...));
+
+  static constexpr std::size_t runtime_count =
+      std::tuple_size_v<runtime_items>;
+
+  /**
+   * @brief header with all compile-time items applied
+   *
+   */
+  static constexpr byte_array<header_size> image = [] {
+    byte_array<header_size> bytes{};
+
+    auto apply = [&]<typename Item>(std::type_identity<Item>) {
+      if constexpr (details::is_builder_tag<Item>) {
+        if constexpr (Item::kind == details::builder_kind::fixed) {
+          details::put_register<typename Item::reg>(bytes.data(),
+                                                    Item::value);
+        }
+      } else if constexpr (details::is_field_value<Item>) {
+        details::put_field<typename Item::field>(bytes.data(), Item::value);
+      }
+    };
+
+    (apply(std::type_identity<Items>{}), ...);
+    return bytes;
+  }();
+
+  static constexpr std::size_t frame_size(std::size_t payload_size) {
+    return header_size + payload_size;
+  }
+
+  /**
+   * @brief write the header for a payload of payload_size bytes, the payload
+   * is left to the caller, e.g. to encode it in place
+   *
+   * @param values one value per runtime item, in the order of Items
+   * @return std::size_t size of the header
+   */
+  template <typename... Values>
+  static std::size_t encode_header(std::span<std::byte> out,
+                                   std::size_t payload_size,
+                                   Values... values) {
+    static_assert(sizeof...(Values) == runtime_count,
+                  "one value per runtime item");
+    ESCAD_ASSERT(out.size() >= header_size, "buffer too small for header");
+
+    auto *pack = out.data();
+    std::memcpy(pack, image.data(), header_size);
+
+    auto length = [&]<typename Item>(std::type_identity<Item>) {
+      if constexpr (details::is_builder_tag<Item>) {
+        using Reg = typename Item::reg;
+        using reg_type = typename Reg::reg_type;
+
+        if constexpr (Item::kind == details::builder_kind::total_length) {
+          details::put_register<Reg>(
+              pack, static_cast<reg_type>(frame_size(payload_size)));
+        } else if constexpr (Item::kind ==
+                             details::builder_kind::payload_length) {
+          details::put_register<Reg>(pack,
+                                          static_cast<reg_type>(payload_size));
+        }
+      }
+    };
+    (length(std::type_identity<Items>{}), ...);
+
+    [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+      [[maybe_unused]] const auto args = std::forward_as_tuple(values...);
+      (put<typename std::tuple_element_t<Index, runtime_items>::type>(pack,
+                                                       std::get<Index>(args)),
+       ...);
+    }(std::make_index_sequence<runtime_count>{});
+
+    return header_size;
+  }
+
+  /**
+   * @brief write header and payload
+   *
+   * @return std::size_t size of the frame
+   */
+  template <typename... Values>
+  static std::size_t encode(std::span<std::byte> out,
+                            std::span<const std::byte> payload,
+                            Values... values) {
+    ESCAD_ASSERT(out.size() >= frame_size(payload.size()),
+                 "buffer too small for frame");
+
+    encode_header(out, payload.size(), values...);
+    if (!payload.empty()) {
+      std::memcpy(out.data() + header_size, payload.data(), payload.size());
+    }
+
+    return frame_size(payload.size());
+  }
+
+ private:
+
+  template <typename Item, typename Value>
+  static void put(std::byte *pack, const Value &value) {
+    if constexpr (details::is_packed_field<Item>) {
+      details::put_field<Item>(
+          pack, static_cast<typename Item::value_type>(value));
+    } else {
+      details::put_register<Item>(
+          pack, static_cast<typename Item::reg_type>(value));
+    }
+  }
+};
+
+} // namespace regs
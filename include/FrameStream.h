@@ -0,0 +1,260 @@
+#pragma once
+
+#include "RegisterBase.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <span>
+
+namespace regs {
+
+/**
+ * @brief Complete frame inside a ring buffer, split in two spans if it wraps
+ * the end of the buffer
+ *
+ */
+struct FrameView {
+  std::span<const std::byte> first;
+  std::span<const std::byte> second;
+
+  std::size_t size() const { return first.size() + second.size(); }
+
+  bool contiguous() const { return second.empty(); }
+
+  /**
+   * @brief byte at position i of the frame
+   *
+   */
+  std::byte operator[](std::size_t i) const {
+    return i < first.size() ? first[i] : second[i - first.size()];
+  }
+
+  /**
+   * @brief copy the bytes [offset, offset + target.size()) of the frame to
+   * target
+   *
+   */
+  void copy_to(std::span<std::byte> target, std::size_t offset = 0) const {
+    ESCAD_ASSERT(offset + target.size() <= size(), "frame too short");
+
+    if (offset < first.size()) {
+      auto head = std::min(target.size(), first.size() - offset);
+      std::memcpy(target.data(), first.data() + offset, head);
+      std::memcpy(target.data() + head, second.data(), target.size() - head);
+    } else {
+      std::memcpy(target.data(), second.data() + (offset - first.size()),
+                  target.size());
+    }
+  }
+
+  /**
+   * @brief read a PackedRegister of a pack starting at pack_offset of the
+   * frame in the byte order of the register, works across the wrap
+   *
+   * @tparam Reg PackedRegister
+   */
+  template <typename Reg>
+  typename Reg::reg_type decode(std::size_t pack_offset = 0) const {
+    byte_array<Reg::size> bytes;
+    copy_to(bytes, pack_offset + Reg::offset);
+    return details::from_bytes<typename Reg::reg_type,
+                               details::byte_order_of<Reg>()>(bytes);
+  }
+};
+
+/**
+ * @brief Decoder cutting frames out of an unframed byte stream
+ *
+ * Chunks of any size are pushed into a fixed-capacity ring buffer. next()
+ * looks for the magic word, checks the total length of the frame header and
+ * hands out each complete frame as a FrameView into the buffer. Bytes in
+ * front of the magic word and frames with an implausible length are dropped.
+ *
+ * @tparam HeaderPack RegisterPack of the frame header, starting with the magic
+ * word
+ * @tparam TotalLengthReg PackedRegister of HeaderPack holding the total frame
+ * length in bytes, header included
+ * @tparam Capacity size of the ring buffer, a power of two
+ * @tparam MagicSize length of the magic word in bytes
+ */
+template <typename HeaderPack, typename TotalLengthReg, std::size_t Capacity,
+          std::size_t MagicSize = 8>
+class FrameStream {
+ public:
+
+ static constexpr std::size_t capacity = Capacity;
+
+ static constexpr std::size_t header_size =
+     sizeof(typename HeaderPack::target_type);
+
+ using magic_type = byte_array<MagicSize>;
+
+ static_assert(std::has_single_bit(Capacity),
+               "capacity must be a power of two");
+ static_assert(MagicSize >= 1 && MagicSize <= header_size,
+               "magic word must be part of the header");
+ static_assert(header_size <= Capacity, "header does not fit the buffer");
+
+ private:
+
+ static constexpr std::size_t index_mask = Capacity - 1;
+
+ std::array<std::byte, Capacity> _buffer;
+
+ magic_type _magic;
+
+ // index of the first unread byte
+ std::size_t _head = 0;
+
+ // number of unread bytes
+ std::size_t _size = 0;
+
+ std::size_t _discarded = 0;
+
+  public:
+
+  explicit FrameStream(magic_type magic) : _magic(magic) {}
+
+  /**
+   * @brief append a chunk of the stream
+   *
+   * Invalidates FrameViews handed out before.
+   *
+   * @return number of bytes taken, less than chunk.size() if the buffer is
+   * full
+   */
+  std::size_t push(std::span<const std::byte> chunk) {
+    auto count = std::min(chunk.size(), Capacity - _size);
+    auto tail = (_head + _size) & index_mask;
+    auto head = std::min(count, Capacity - tail);
+
+    std::memcpy(_buffer.data() + tail, chunk.data(), head);
+    std::memcpy(_buffer.data(), chunk.data() + head, count - head);
+
+    _size += count;
+    return count;
+  }
+
+  /**
+   * @brief next complete frame of the stream
+   *
+   * The frame is consumed, the view stays valid until the next push().
+   *
+   * @return std::optional<FrameView> nothing if no complete frame is buffered
+   */
+  std::optional<FrameView> next() {
+    while (sync()) {
+      if (_size < header_size) {
+        return std::nullopt;
+      }
+
+      auto length = static_cast<std::size_t>(
+          view(header_size).template decode<TotalLengthReg>());
+
+      if (length < header_size || length > Capacity) {
+        // corrupt header, search again behind this magic word
+        drop(1);
+        continue;
+      }
+
+      if (_size < length) {
+        return std::nullopt;
+      }
+
+      auto frame = view(length);
+      _head = (_head + length) & index_mask;
+      _size -= length;
+
+      return frame;
+    }
+
+    return std::nullopt;
+  }
+
+  /**
+   * @brief number of unread bytes
+   *
+   */
+  std::size_t size() const { return _size; }
+
+  /**
+   * @brief number of bytes dropped while searching the magic word
+   *
+   */
+  std::size_t discarded() const { return _discarded; }
+
+  void clear() {
+    _head = 0;
+    _size = 0;
+  }
+
+ private:
+
+  FrameView view(std::size_t length) const {
+    auto head = std::min(length, Capacity - _head);
+    return {{_buffer.data() + _head, head}, {_buffer.data(), length - head}};
+  }
+
+  void drop(std::size_t count) {
+    _head = (_head + count) & index_mask;
+    _size -= count;
+    _discarded += count;
+  }
+
+  bool magic_at(std::size_t position) const {
+    for (std::size_t i = 1; i < MagicSize; i++) {
+      if (_buffer[(position + i) & index_mask] != _magic[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief drop all bytes in front of the next magic word
+   *
+   * The scan for the first magic byte uses memchr on each contiguous part of
+   * the buffer, which libc vectorizes.
+   *
+   * @return true if the buffer starts with the magic word
+   */
+  bool sync() {
+    const auto first = std::to_integer<int>(_magic[0]);
+
+    std::size_t scanned = 0;
+
+    while (_size - scanned >= MagicSize) {
+      auto start = (_head + scanned) & index_mask;
+      // candidates are the positions followed by a complete magic word
+      auto candidates = _size - scanned - MagicSize + 1;
+      auto length = std::min(candidates, Capacity - start);
+
+      auto *found = static_cast<const std::byte *>(
+          std::memchr(_buffer.data() + start, first, length));
+
+      if (found == nullptr) {
+        scanned += length;
+        continue;
+      }
+
+      auto position = static_cast<std::size_t>(found - _buffer.data());
+      scanned += position - start;
+
+      if (magic_at(position)) {
+        drop(scanned);
+        return true;
+      }
+
+      scanned++;
+    }
+
+    // keep a possible beginning of the magic word
+    drop(scanned);
+    return false;
+  }
+};
+
+} // namespace regs
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "RegisterBase.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace regs {
+
+/**
+ * @brief Register located at a fixed address in device memory
+ *
+ * Every access is exactly one volatile load or store of reg_type, field
+ * writes are a single read-modify-write of the whole register.
+ *
+ * @tparam Reg derived register
+ * @tparam Reg_type underlying type, sets the bus access width
+ * @tparam Address address of the register
+ */
+template <typename Reg, typename Reg_type, std::uintptr_t Address>
+class MmioRegister : public RegisterBase<Reg, Reg_type> {
+ public:
+
+ using reg = Reg;
+ using reg_type = Reg_type;
+
+ static constexpr size_t size = sizeof(reg_type);
+
+ static constexpr std::uintptr_t address = Address;
+
+ using target_type = byte_array<size>;
+
+ static_assert(std::is_integral_v<reg_type>,
+               "mmio registers need an integral access type");
+ static_assert(Address % alignof(reg_type) == 0,
+               "mmio register address is misaligned");
+
+  public:
+
+  static volatile reg_type *pointer() {
+    return reinterpret_cast<volatile reg_type *>(Address);
+  }
+
+  reg_type load() const { return *pointer(); }
+
+  void store(reg_type value) { *pointer() = value; }
+};
+
+/**
+ * @brief Register at a fixed offset into device memory that is mapped at
+ * runtime, e.g. through /dev/mem or a UIO device
+ *
+ * Accesses are the same single volatile loads and stores as with
+ * MmioRegister, the address is the base of the mapping plus Offset.
+ *
+ * @tparam Reg derived register
+ * @tparam Reg_type underlying type, sets the bus access width
+ * @tparam Offset byte offset of the register from the base of the mapping
+ */
+template <typename Reg, typename Reg_type, std::size_t Offset>
+class MappedRegister : public RegisterBase<Reg, Reg_type> {
+ public:
+
+ using reg = Reg;
+ using reg_type = Reg_type;
+
+ static constexpr size_t size = sizeof(reg_type);
+
+ static constexpr std::size_t offset = Offset;
+
+ using target_type = byte_array<size>;
+
+ static_assert(std::is_integral_v<reg_type>,
+               "mmio registers need an integral access type");
+ static_assert(Offset % alignof(reg_type) == 0,
+               "mmio register offset is misaligned");
+
+ private:
+
+ volatile std::byte *_base;
+
+  public:
+
+  /**
+   * @param base start of the mapping, aligned for reg_type
+   */
+  explicit MappedRegister(volatile void *base)
+      : _base(static_cast<volatile std::byte *>(base)) {
+    ESCAD_ASSERT(reinterpret_cast<std::uintptr_t>(base) % alignof(reg_type) ==
+                     0,
+                 "mmio register base is misaligned");
+  }
+
+  volatile reg_type *pointer() const {
+    return reinterpret_cast<volatile reg_type *>(_base + Offset);
+  }
+
+  reg_type load() const { return *pointer(); }
+
+  void store(reg_type value) { *pointer() = value; }
+};
+
+} // namespace regs
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Bytes.h"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace regs {
+
+/**
+ * @brief changed bytes [offset, offset + length) of a pack
+ *
+ */
+struct byte_range {
+  std::uint32_t offset;
+  std::uint32_t length;
+
+  bool operator==(const byte_range &) const = default;
+};
+
+/**
+ * @brief Changes between two snapshots of a pack, a list of byte ranges with
+ * their new bytes
+ *
+ * Adjacent ranges are merged. The buffers are kept over clear(), so diffing
+ * into the same delta again does not allocate.
+ *
+ */
+class PackDelta {
+ std::vector<byte_range> _ranges;
+ std::vector<std::byte> _bytes;
+
+  public:
+
+  const std::vector<byte_range> &ranges() const { return _ranges; }
+
+  /**
+   * @brief new bytes of all ranges, back to back
+   *
+   */
+  std::span<const std::byte> bytes() const { return _bytes; }
+
+  bool empty() const { return _ranges.empty(); }
+
+  void clear() {
+    _ranges.clear();
+    _bytes.clear();
+  }
+
+  /**
+   * @brief append changed bytes at offset, merged into the last range if
+   * adjacent
+   *
+   */
+  void add(std::size_t offset, std::span<const std::byte> bytes) {
+    if (!_ranges.empty() &&
+        _ranges.back().offset + _ranges.back().length == offset) {
+      _ranges.back().length += static_cast<std::uint32_t>(bytes.size());
+    } else {
+      _ranges.push_back({static_cast<std::uint32_t>(offset),
+                         static_cast<std::uint32_t>(bytes.size())});
+    }
+    _bytes.insert(_bytes.end(), bytes.begin(), bytes.end());
+  }
+
+  /**
+   * @brief call f(offset, bytes) for every range
+   *
+   */
+  template <typename F> void for_each(F &&f) const {
+    std::size_t position = 0;
+    for (const auto &range : _ranges) {
+      f(std::size_t{range.offset},
+        std::span<const std::byte>{_bytes.data() + position, range.length});
+      position += range.length;
+    }
+  }
+};
+
+namespace details {
+
+/**
+ * @brief add the runs of set bits of changed, a bit per byte starting at
+ * offset base, to delta
+ *
+ */
+inline void add_changed(PackDelta &delta, const std::byte *b, std::size_t base,
+                        std::uint64_t changed) {
+  while (changed != 0) {
+    auto start = static_cast<unsigned>(std::countr_zero(changed));
+    auto run = static_cast<unsigned>(std::countr_one(changed >> start));
+    delta.add(base + start, {b + base + start, run});
+
+    auto end = start + run;
+    changed = end >= 64 ? 0 : changed & (~std::uint64_t{0} << end);
+  }
+}
+
+/**
+ * @brief append the bytes of b differing from a to delta
+ *
+ * Equal blocks are skipped after one compare: 32 bytes with AVX2, 16 bytes
+ * with SSE2, 8 bytes otherwise. Only blocks that differ are looked at byte by
+ * byte, through the compare mask.
+ *
+ */
+inline void diff_bytes(const std::byte *a, const std::byte *b, std::size_t n,
+                       PackDelta &delta) {
+  std::size_t i = 0;
+
+#if defined(__AVX2__)
+  for (; i + 32 <= n; i += 32) {
+    auto equal = _mm256_cmpeq_epi8(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i)),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i)));
+    auto changed = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(equal));
+    if (changed != 0) {
+      add_changed(delta, b, i, changed);
+    }
+  }
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+  for (; i + 16 <= n; i += 16) {
+    auto equal = _mm_cmpeq_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i)));
+    auto changed = ~static_cast<std::uint32_t>(_mm_movemask_epi8(equal)) &
+                   0xFFFFu;
+    if (changed != 0) {
+      add_changed(delta, b, i, changed);
+    }
+  }
+#endif
+
+  for (; i + 8 <= n; i += 8) {
+    std::uint64_t wa, wb;
+    std::memcpy(&wa, a + i, 8);
+    std::memcpy(&wb, b + i, 8);
+    if (wa != wb) {
+      std::uint64_t changed = 0;
+      for (unsigned j = 0; j < 8; j++) {
+        changed |= std::uint64_t{a[i + j] != b[i + j]} << j;
+      }
+      add_changed(delta, b, i, changed);
+    }
+  }
+
+  for (; i < n; i++) {
+    if (a[i] != b[i]) {
+      delta.add(i, {b + i, 1});
+    }
+  }
+}
+
+} // namespace details
+
+} // namespace regs
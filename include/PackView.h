@@ -0,0 +1,196 @@
+#pragma once
+
+#include "RegisterBase.h"
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+namespace regs {
+
+namespace details {
+
+/**
+ * @brief read field TField from the bytes of its register
+ *
+ */
+template <typename TField>
+constexpr typename TField::value_type
+read_field(std::span<const std::byte> reg_bytes) {
+  using Reg = typename TField::reg;
+  using Word = uint_for_bytes_t<Reg::size>;
+
+  if constexpr (is_word_sized<Reg>) {
+    return TField::extract(details::from_bytes<Word, byte_order_of<Reg>()>(
+        to_byte_array<Reg::size>(reg_bytes)));
+  } else {
+    static_assert(byte_order_of<Reg>() == std::endian::native,
+                  "byte swapped registers need a native word");
+    return TField::read(reg_bytes);
+  }
+}
+
+/**
+ * @brief read field index of FieldArray TArray from the bytes of its register
+ *
+ */
+template <typename TArray>
+constexpr typename TArray::value_type
+read_field(std::span<const std::byte> reg_bytes, std::size_t index) {
+  using Reg = typename TArray::reg;
+  using Word = uint_for_bytes_t<Reg::size>;
+
+  if constexpr (is_word_sized<Reg>) {
+    return TArray::extract(details::from_bytes<Word, byte_order_of<Reg>()>(
+                               to_byte_array<Reg::size>(reg_bytes)),
+                           index);
+  } else {
+    static_assert(byte_order_of<Reg>() == std::endian::native,
+                  "byte swapped registers need a native word");
+    return TArray::read(reg_bytes, index);
+  }
+}
+
+} // namespace details
+
+/**
+ * @brief Non-owning view of a RegisterPack laid over a byte buffer
+ *
+ * Replaces placement new of a pack onto received bytes. A mutable view hands
+ * out PackedRegisters bound to the buffer, so every register and
+ * RegisterArray accessor works on it; PackView<const Pack> only decodes.
+ *
+ * Registers keep the base pointer of the buffer only, a whole decode runs
+ * off one pointer.
+ *
+ * @tparam Pack RegisterPack, const for a read-only view
+ * @tparam Extent size of the buffer, std::dynamic_extent if only known at
+ * runtime
+ */
+template <typename Pack,
+          std::size_t Extent =
+              sizeof(typename std::remove_const_t<Pack>::target_type)>
+class PackView {
+ public:
+
+ using pack_type = std::remove_const_t<Pack>;
+ using byte_type =
+     std::conditional_t<std::is_const_v<Pack>, const std::byte, std::byte>;
+
+ static constexpr std::size_t pack_size =
+     sizeof(typename pack_type::target_type);
+
+ static constexpr std::size_t extent = Extent;
+
+ static_assert(Extent == std::dynamic_extent || Extent >= pack_size,
+               "buffer smaller than pack");
+
+ private:
+
+ std::span<byte_type, Extent> _bytes;
+
+  public:
+
+  constexpr explicit PackView(std::span<byte_type, Extent> bytes)
+      : _bytes(bytes) {
+    ESCAD_ASSERT(_bytes.size() >= pack_size, "buffer smaller than pack");
+  }
+
+  /**
+   * @brief view of an owning pack
+   *
+   */
+  constexpr PackView(std::conditional_t<std::is_const_v<Pack>, const pack_type,
+                                        pack_type> &pack)
+    requires(Extent == pack_size)
+      : _bytes(pack._target) {}
+
+  /**
+   * @brief views of other extent or mutability, a mutable view converts to a
+   * read-only one but not the other way round
+   *
+   */
+  template <typename Other, std::size_t OtherExtent>
+    requires std::same_as<std::remove_const_t<Other>, pack_type> &&
+             (std::is_const_v<Pack> || !std::is_const_v<Other>) &&
+             (!std::same_as<PackView<Other, OtherExtent>, PackView>)
+  constexpr PackView(PackView<Other, OtherExtent> other)
+      : _bytes(other.data(), Extent == std::dynamic_extent ? other.size()
+                                                           : Extent) {
+    ESCAD_ASSERT(other.size() >= pack_size, "buffer smaller than pack");
+  }
+
+  constexpr byte_type *data() const { return _bytes.data(); }
+
+  constexpr std::size_t size() const { return _bytes.size(); }
+
+  /**
+   * @brief bytes of the pack, without any bytes following it in the buffer
+   *
+   */
+  constexpr std::span<byte_type, pack_size> span() const {
+    return std::span<byte_type, pack_size>{_bytes.data(), pack_size};
+  }
+
+  /**
+   * @brief register Reg bound to the viewed bytes
+   *
+   */
+  template <typename Reg>
+    requires std::same_as<pack_type, typename Reg::reg_pack> &&
+             (!std::is_const_v<Pack>)
+  constexpr Reg reg() const {
+    return Reg{*this};
+  }
+
+  /**
+   * @brief read a PackedRegister of the pack
+   *
+   */
+  template <typename Reg>
+    requires std::same_as<pack_type, typename Reg::reg_pack>
+  constexpr typename Reg::reg_type decode() const {
+    return Reg::decode(std::span<const std::byte>{_bytes});
+  }
+
+  /**
+   * @brief read a field of a PackedRegister of the pack
+   *
+   */
+  template <typename TField>
+    requires std::same_as<pack_type, typename TField::reg::reg_pack>
+  constexpr typename TField::value_type read() const {
+    using Reg = typename TField::reg;
+    return details::read_field<TField>(
+        std::span<const std::byte>{_bytes}.subspan(Reg::offset, Reg::size));
+  }
+
+  /**
+   * @brief read field index of a FieldArray of a PackedRegister of the pack
+   *
+   */
+  template <typename TArray>
+    requires std::same_as<pack_type, typename TArray::reg::reg_pack>
+  constexpr typename TArray::value_type read(std::size_t index) const {
+    using Reg = typename TArray::reg;
+    return details::read_field<TArray>(
+        std::span<const std::byte>{_bytes}.subspan(Reg::offset, Reg::size),
+        index);
+  }
+
+  /**
+   * @brief view of another pack starting offset bytes into this buffer, e.g.
+   * the TLV behind a frame header
+   *
+   */
+  template <typename Other>
+  constexpr auto overlay(std::size_t offset) const {
+    using Viewed =
+        std::conditional_t<std::is_const_v<Pack>, const Other, Other>;
+    return PackView<Viewed, std::dynamic_extent>{_bytes.subspan(offset)};
+  }
+};
+
+template <typename Pack>
+PackView(Pack &) -> PackView<Pack>;
+
+} // namespace regs
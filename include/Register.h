@@ -10,13 +10,23 @@ namespace regs {
  */
 struct noInit {};
 
-template <typename Reg, typename Reg_type>
+/**
+ * @brief Register holding its bytes
+ *
+ * @tparam Reg derived register
+ * @tparam Reg_type underlying type
+ * @tparam Order byte order of the stored bytes
+ */
+template <typename Reg, typename Reg_type,
+          std::endian Order = std::endian::native>
 class Register : public RegisterBase<Reg, Reg_type> {
  public:
 
  using reg = Reg;
  using reg_type = Reg_type;
 
+ static constexpr std::endian byte_order = Order;
+
  static constexpr size_t size = sizeof(reg_type); 
 
  using target_type = byte_array<size>;
@@ -30,19 +40,21 @@ class Register : public RegisterBase<Reg, Reg_type> {
    * @brief Default constructor with initialization
    *
    */
-  explicit Register() : _target() {}
+  constexpr explicit Register() : _target() {}
 
   /**
    * @brief Tagged constructor without initialization, to be used with placement
    * new
    *
    */
-  explicit Register(noInit) {}
+  constexpr explicit Register(noInit) {}
 
-  auto span(){
+  constexpr auto span(){
     return std::span{_target};
   }
 
+  constexpr target_type const_target() const { return _target; }
+
 
 
 
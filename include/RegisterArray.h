@@ -1,83 +1,298 @@
 #pragma once
 
+#include "Columns.h"
 #include "Fields.h"
+#include "PackView.h"
+#include "RegisterBase.h"
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstring>
+#include <utility>
 
 namespace regs {
 
 template <typename Reg, unsigned Offset, unsigned Width, std::size_t Count,
           unsigned Stride = Width, unsigned StartByte = 0,
           typename Access = read_write,
-          typename ValueType = typename Reg::reg_type>
+          typename ValueType = typename Reg::reg_type,
+          ValueType Reset = ValueType{}>
 struct FieldArray {
   using reg = Reg;
+  using access = Access;
   using value_type = ValueType;
 
   static constexpr std::size_t count = Count;
 
+  // value of every field after reset
+  static constexpr value_type reset_value = Reset;
+
   template <std::size_t Index>
   using field = Field<Reg, Offset + (Index * Stride), Width, StartByte, Access,
-                      ValueType>;
+                      ValueType, Reset>;
 
   template <std::size_t Index>
-  static value_type read(std::span<const std::byte> target) {
+  static constexpr value_type read(std::span<const std::byte> target) {
     static_assert(Index < count, "field index out of bounds");
     return field<Index>::read(target);
   }
 
-  static value_type read(std::span<const std::byte> target,
-                         std::size_t index) {
-    return read_runtime<0>(target, index);
+  static constexpr value_type read(std::span<const std::byte> target,
+                                   std::size_t index) {
+    ESCAD_ASSERT(index < count, "FieldArray runtime index out of range");
+
+    if constexpr (word_indexed) {
+      return extract(
+          load_word<word_type, sizeof(target_type)>(target.data()), index);
+    } else {
+      if (index >= count) {
+        return value_type{};
+      }
+      return readers<>[index](target);
+    }
   }
 
   template <std::size_t Index>
-  static void write(std::span<std::byte> target, value_type value) {
+  static constexpr void write(std::span<std::byte> target,
+                              value_type value) {
     static_assert(Index < count, "field index out of bounds");
     field<Index>::write(target, value);
   }
 
-  static void write(std::span<std::byte> target, std::size_t index,
-                    value_type value) {
-    write_runtime<0>(target, index, value);
+  static constexpr void write(std::span<std::byte> target, std::size_t index,
+                              value_type value)
+    requires details::is_writeable<Access>
+  {
+    ESCAD_ASSERT(index < count, "FieldArray runtime index out of range");
+
+    if constexpr (word_indexed) {
+      auto word = load_word<word_type, sizeof(target_type)>(target.data());
+      store_word<sizeof(target_type)>(target.data(),
+                                      insert(word, index, value));
+    } else {
+      if (index >= count) {
+        return;
+      }
+      writers<>[index](target, value);
+    }
   }
 
   template <std::size_t Index, value_type Value>
-  static bool is(std::span<const std::byte> target) {
+  static constexpr bool is(std::span<const std::byte> target) {
     static_assert(Index < count, "field index out of bounds");
     return field<Index>::template is<Value>(target);
   }
 
- private:
-  template <std::size_t Index>
-  static value_type read_runtime(std::span<const std::byte> target,
-                                 std::size_t index) {
-    if (index == Index) {
-      return field<Index>::read(target);
+  /**
+   * @brief read every field with one load of the register
+   *
+   */
+  static constexpr std::array<value_type, count>
+  read_all(std::span<const std::byte> target) {
+    if constexpr (word_indexed) {
+      return extract_all(
+          load_word<word_type, sizeof(target_type)>(target.data()));
+    } else {
+      std::array<value_type, count> values;
+      for (std::size_t i = 0; i < count; i++) {
+        values[i] = read(target, i);
+      }
+      return values;
     }
+  }
 
-    if constexpr (Index + 1 < count) {
-      return read_runtime<Index + 1>(target, index);
+  /**
+   * @brief write the first values.size() fields with one read-modify-write
+   * of the register
+   *
+   */
+  static constexpr void write_all(std::span<std::byte> target,
+                                  std::span<const value_type> values)
+    requires details::is_writeable<Access>
+  {
+    ESCAD_ASSERT(values.size() <= count, "too many values for FieldArray");
+
+    if constexpr (word_indexed) {
+      auto word = load_word<word_type, sizeof(target_type)>(target.data());
+      store_word<sizeof(target_type)>(target.data(),
+                                      insert_all(word, values));
+    } else {
+      for (std::size_t i = 0; i < values.size(); i++) {
+        write(target, i, values[i]);
+      }
     }
+  }
 
-    ESCAD_ASSERT(false, "FieldArray runtime index out of range");
-    return value_type{};
+  /**
+   * @brief set every field to value with one read-modify-write of the
+   * register
+   *
+   */
+  static constexpr void fill(std::span<std::byte> target, value_type value)
+    requires details::is_writeable<Access>
+  {
+    if constexpr (word_indexed) {
+      auto word = load_word<word_type, sizeof(target_type)>(target.data());
+      store_word<sizeof(target_type)>(target.data(), insert_fill(word, value));
+    } else {
+      for (std::size_t i = 0; i < count; i++) {
+        write(target, i, value);
+      }
+    }
   }
 
-  template <std::size_t Index>
-  static void write_runtime(std::span<std::byte> target, std::size_t index,
-                            value_type value) {
-    if (index == Index) {
-      field<Index>::write(target, value);
-      return;
+  /**
+   * @brief call f(index, value) for every field, from one load of the
+   * register
+   *
+   */
+  template <typename F>
+  static constexpr void for_each(std::span<const std::byte> target,
+                                 F &&f) {
+    const auto values = read_all(target);
+    for (std::size_t i = 0; i < count; i++) {
+      f(i, values[i]);
     }
+  }
 
-    if constexpr (Index + 1 < count) {
-      write_runtime<Index + 1>(target, index, value);
-      return;
+  /**
+   * @brief extract field index from the register as native word, the bit
+   * position is computed as Offset + index * Stride
+   *
+   */
+  template <typename Word>
+  static constexpr value_type extract(Word word, std::size_t index) {
+    ESCAD_ASSERT(index < count, "FieldArray runtime index out of range");
+
+    // out of range indexes read as zero in release builds
+    if (index >= count) {
+      return value_type{};
+    }
+
+    const auto shift = field<0>::shift + index * Stride;
+
+    return details::from_bits<value_type>(
+        static_cast<Word>(static_cast<Word>(word >> shift) & value_mask<Word>));
+  }
+
+  template <typename Word>
+  static constexpr Word insert(Word word, std::size_t index,
+                               value_type value) {
+    ESCAD_ASSERT(index < count, "FieldArray runtime index out of range");
+
+    // out of range indexes leave the word untouched in release builds
+    if (index >= count) {
+      return word;
+    }
+
+    const auto shift = field<0>::shift + index * Stride;
+    const auto mask = static_cast<Word>(value_mask<Word> << shift);
+
+    return static_cast<Word>(
+        (word & static_cast<Word>(~mask)) |
+        (static_cast<Word>(details::to_bits<Word>(value) << shift) & mask));
+  }
+
+  template <typename Word>
+  static constexpr std::array<value_type, count> extract_all(Word word) {
+    std::array<value_type, count> values;
+    for (std::size_t i = 0; i < count; i++) {
+      values[i] = extract(word, i);
+    }
+    return values;
+  }
+
+  template <typename Word>
+  static constexpr Word insert_all(Word word,
+                                   std::span<const value_type> values) {
+    ESCAD_ASSERT(values.size() <= count, "too many values for FieldArray");
+
+    Word mask{0};
+    Word bits{0};
+
+    // surplus values are dropped in release builds
+    const auto used = std::min(values.size(), count);
+    for (std::size_t i = 0; i < used; i++) {
+      const auto shift = field<0>::shift + i * Stride;
+      mask |= static_cast<Word>(value_mask<Word> << shift);
+      bits |= static_cast<Word>(
+          (details::to_bits<Word>(values[i]) & value_mask<Word>) << shift);
+    }
+
+    return static_cast<Word>((word & static_cast<Word>(~mask)) | bits);
+  }
+
+  template <typename Word>
+  static constexpr Word insert_fill(Word word, value_type value) {
+    const auto pattern =
+        static_cast<Word>(details::to_bits<Word>(value) & value_mask<Word>);
+
+    Word bits{0};
+    for (std::size_t i = 0; i < count; i++) {
+      bits |= static_cast<Word>(pattern << (field<0>::shift + i * Stride));
+    }
+
+    return static_cast<Word>((word & static_cast<Word>(~all_mask<Word>)) |
+                             bits);
+  }
+
+ private:
+  using target_type = typename Reg::target_type;
+  using word_type = typename field<0>::word_type;
+
+  static_assert(StartByte * 8 + Offset + (Count - 1) * Stride + Width <=
+                    sizeof(target_type) * 8,
+                "field array exceeds register");
+
+  // runtime indexes are resolved arithmetically if the register fits a
+  // native word, through a table of the instantiated fields otherwise
+  static constexpr bool word_indexed =
+      !std::is_void_v<word_type> &&
+      (std::integral<value_type> || std::is_enum_v<value_type>);
+
+  template <typename Word>
+  static constexpr auto value_mask =
+      static_cast<Word>(details::make_word_mask<Word>(0, Width));
+
+  template <typename Word>
+  static constexpr auto all_mask = [] {
+    Word mask{0};
+    for (std::size_t i = 0; i < count; i++) {
+      mask |= static_cast<Word>(value_mask<Word>
+                                << (field<0>::shift + i * Stride));
     }
+    return mask;
+  }();
+
+  template <std::size_t... Index>
+  static constexpr auto make_readers(std::index_sequence<Index...>) {
+    using reader = value_type (*)(std::span<const std::byte>);
+    return std::array<reader, count>{
+        +[](std::span<const std::byte> target) -> value_type {
+          return field<Index>::read(target);
+        }...};
+  }
 
-    ESCAD_ASSERT(false, "FieldArray runtime index out of range");
+  template <std::size_t... Index>
+  static constexpr auto make_writers(std::index_sequence<Index...>) {
+    using writer = void (*)(std::span<std::byte>, value_type);
+    return std::array<writer, count>{
+        +[](std::span<std::byte> target, value_type value) {
+          field<Index>::write(target, value);
+        }...};
   }
+
+  // per index accessors of fields without native word, for runtime indexes,
+  // built on first use only
+  template <typename = void>
+    requires details::is_readable<Access>
+  static constexpr auto readers =
+      make_readers(std::make_index_sequence<count>{});
+
+  template <typename = void>
+    requires details::is_writeable<Access>
+  static constexpr auto writers =
+      make_writers(std::make_index_sequence<count>{});
 };
 
 template <template <unsigned> typename Reg, unsigned Offset,
@@ -88,65 +303,243 @@ struct RegisterArray {
   using reg_type = typename Reg<Offset>::reg_type;
   using reg_pack = typename Reg<Offset>::reg_pack;
 
+  static constexpr std::endian byte_order =
+      details::byte_order_of<Reg<Offset>>();
+
+  // bytes covered within the pack, gaps between registers included
+  static constexpr std::size_t offset = Offset;
+  static constexpr std::size_t size = (Count - 1) * Stride + sizeof(reg_type);
+
   template <std::size_t Index>
   using reg = Reg<Offset + (Index * Stride)>;
 
   template <std::size_t Index>
-  static reg<Index> at(reg_pack &pack) {
+  static constexpr reg<Index> at(PackView<reg_pack> pack) {
     static_assert(Index < count, "register index out of bounds");
     return reg<Index>{pack};
   }
 
+  // reads take a read-only view, owning packs and mutable views convert to it
+
   template <std::size_t Index>
-  static reg_type read(reg_pack &pack) {
+  static constexpr reg_type read(PackView<const reg_pack> pack) {
     static_assert(Index < count, "register index out of bounds");
-    return at<Index>(pack).read();
+    const auto value = pack.template decode<reg<Index>>();
+    trace_register<Index>(trace_op::read, pack.data(), value);
+    return value;
   }
 
-  static reg_type read(reg_pack &pack, std::size_t index) {
-    return read_runtime<0>(pack, index);
+  static constexpr reg_type read(PackView<const reg_pack> pack,
+                                 std::size_t index) {
+    ESCAD_ASSERT(index < count, "RegisterArray runtime index out of range");
+    if (index >= count) {
+      return reg_type{};
+    }
+    const auto value = decode(pack.span(), index);
+    trace_index(trace_op::read, pack.data(), index, value);
+    return value;
+  }
+
+  /**
+   * @brief read register index straight from the bytes of a pack, without a
+   * pack object
+   *
+   */
+  static constexpr reg_type decode(std::span<const std::byte> pack_bytes,
+                                   std::size_t index) {
+    ESCAD_ASSERT(pack_bytes.size() >= Offset + index * Stride + sizeof(reg_type),
+                 "pack too short for register");
+    return details::from_bytes<reg_type, byte_order>(
+        to_byte_array<sizeof(reg_type)>(
+            pack_bytes.subspan(Offset + index * Stride, sizeof(reg_type))));
+  }
+
+  /**
+   * @brief decode a number of records of payload into values
+   *
+   * Densely packed records are copied in one go and, if stored in foreign
+   * byte order, swapped in place with vector shuffles where available.
+   *
+   * @param payload bytes holding the records
+   * @param records number of records, not limited to the size of the array
+   * @param values at least records values
+   */
+  static void decode_all(std::span<const std::byte> payload,
+                         std::size_t records, std::span<reg_type> values) {
+    ESCAD_ASSERT(records == 0 ||
+                     payload.size() >=
+                         Offset + (records - 1) * Stride + sizeof(reg_type),
+                 "payload too short for records");
+    ESCAD_ASSERT(values.size() >= records, "too few values");
+
+    if constexpr (Stride == sizeof(reg_type)) {
+      std::memcpy(values.data(), payload.data() + Offset,
+                  records * sizeof(reg_type));
+
+      if constexpr (byte_order != std::endian::native) {
+        details::byteswap_all(values.first(records));
+      }
+    } else {
+      for (std::size_t i = 0; i < records; i++) {
+        values[i] = decode(payload, i);
+      }
+    }
+  }
+
+  /**
+   * @brief decode a number of records of payload into one column per field
+   *
+   * Record index starts at byte Offset + index * Stride of payload, the number
+   * of records is not limited to the size of the array. Whole 32 bit fields in the first 16
+   * bytes of the record are transposed several records at a time with
+   * SSE2/AVX2 where available, all other fields are read record by record.
+   *
+   * @tparam TFields fields of the register, one per column
+   * @param payload bytes holding the records
+   * @param records number of records
+   * @param columns one column per field, at least records values each
+   */
+  template <typename... TFields>
+  static void decode_columns(std::span<const std::byte> payload,
+                             std::size_t records,
+                             std::span<typename TFields::value_type>... columns) {
+    ESCAD_ASSERT(records == 0 ||
+                     payload.size() >=
+                         Offset + (records - 1) * Stride + sizeof(reg_type),
+                 "payload too short for records");
+    ESCAD_ASSERT(((columns.size() >= records) && ...), "column too short");
+
+    std::size_t decoded = 0;
+
+    if constexpr (byte_order != std::endian::native) {
+      // fields are defined on the swapped value
+      for (; decoded < records; decoded++) {
+        const auto word =
+            std::bit_cast<uint_for_bytes_t<sizeof(reg_type)>>(
+                decode(payload, decoded));
+        ((columns[decoded] = TFields::extract(word)), ...);
+      }
+    } else if constexpr (details::is_word32_columns<TFields...> &&
+                         sizeof(reg_type) >= 16) {
+      std::array<std::byte *, 4> targets{};
+      ((targets[TFields::byte_offset / 4] =
+            reinterpret_cast<std::byte *>(columns.data())),
+       ...);
+
+      decoded = details::transpose_words32(payload.data() + Offset, Stride,
+                                           records, targets);
+    }
+
+    for (std::size_t i = decoded; i < records; i++) {
+      auto record = payload.subspan(Offset + i * Stride, sizeof(reg_type));
+      ((columns[i] = details::read_column<TFields>(record)), ...);
+    }
   }
 
   template <std::size_t Index>
-  static void write(reg_pack &pack, reg_type value) {
+  static constexpr void write(PackView<reg_pack> pack, reg_type value) {
     static_assert(Index < count, "register index out of bounds");
     at<Index>(pack).write(value);
   }
 
-  static void write(reg_pack &pack, std::size_t index, reg_type value) {
-    write_runtime<0>(pack, index, value);
+  static constexpr void write(PackView<reg_pack> pack, std::size_t index,
+                              reg_type value) {
+    ESCAD_ASSERT(index < count, "RegisterArray runtime index out of range");
+    if (index >= count) {
+      return;
+    }
+    auto bytes = details::to_bytes<byte_order>(value);
+    std::copy(bytes.begin(), bytes.end(), target(pack, index).begin());
+    trace_index(trace_op::write, pack.data(), index, value);
   }
 
- private:
-  template <std::size_t Index>
-  static reg_type read_runtime(reg_pack &pack, std::size_t index) {
-    if (index == Index) {
-      return at<Index>(pack).read();
+  static constexpr std::array<reg_type, count>
+  read_all(PackView<const reg_pack> pack) {
+    std::array<reg_type, count> values;
+    for (std::size_t i = 0; i < count; i++) {
+      values[i] = read(pack, i);
     }
+    return values;
+  }
+
+  /**
+   * @brief write the first values.size() registers
+   *
+   */
+  static constexpr void write_all(PackView<reg_pack> pack,
+                                  std::span<const reg_type> values) {
+    ESCAD_ASSERT(values.size() <= count, "too many values for RegisterArray");
+    for (std::size_t i = 0; i < values.size(); i++) {
+      write(pack, i, values[i]);
+    }
+  }
 
-    if constexpr (Index + 1 < count) {
-      return read_runtime<Index + 1>(pack, index);
+  static constexpr void fill(PackView<reg_pack> pack, reg_type value) {
+    for (std::size_t i = 0; i < count; i++) {
+      write(pack, i, value);
     }
+  }
+
+  /**
+   * @brief call f(index, reg) for every register, reg being the typed
+   * register so field operations of each register are available
+   *
+   */
+  template <typename F>
+  static constexpr void for_each(PackView<reg_pack> pack, F &&f) {
+    for_each_impl(pack, f, std::make_index_sequence<count>{});
+  }
 
-    ESCAD_ASSERT(false, "RegisterArray runtime index out of range");
-    return reg_type{};
+ private:
+  static_assert(Offset + (Count - 1) * Stride + sizeof(reg_type) <=
+                    sizeof(typename reg_pack::target_type),
+                "register array exceeds pack");
+
+  template <typename F, std::size_t... Index>
+  static constexpr void for_each_impl(PackView<reg_pack> pack, F &f,
+                                      std::index_sequence<Index...>) {
+    (f(Index, at<Index>(pack)), ...);
   }
 
+  // accesses without a register object are recorded like the ones through
+  // at<Index>(), with the address of the register bytes as register
   template <std::size_t Index>
-  static void write_runtime(reg_pack &pack, std::size_t index,
-                            reg_type value) {
-    if (index == Index) {
-      at<Index>(pack).write(value);
-      return;
+  static constexpr void trace_register([[maybe_unused]] trace_op op,
+                                       [[maybe_unused]] const std::byte *pack,
+                                       [[maybe_unused]] reg_type value) {
+    using traced = reg<Index>;
+    if constexpr (trace_policy<traced>::type::enabled) {
+      if (!std::is_constant_evaluated()) {
+        trace_policy<traced>::type::template record<traced, traced>(
+            op, pack + traced::offset, 0, value);
+      }
     }
+  }
 
-    if constexpr (Index + 1 < count) {
-      write_runtime<Index + 1>(pack, index, value);
-      return;
+  static constexpr void trace_index(trace_op op, const std::byte *pack,
+                                    std::size_t index, reg_type value) {
+    trace_index_impl(op, pack, index, value, std::make_index_sequence<count>{});
+  }
+
+  template <std::size_t... Index>
+  static constexpr void
+  trace_index_impl([[maybe_unused]] trace_op op,
+                   [[maybe_unused]] const std::byte *pack,
+                   [[maybe_unused]] std::size_t index,
+                   [[maybe_unused]] reg_type value,
+                   std::index_sequence<Index...>) {
+    if constexpr ((trace_policy<reg<Index>>::type::enabled || ...)) {
+      ((index == Index ? trace_register<Index>(op, pack, value) : void()),
+       ...);
     }
+  }
 
-    ESCAD_ASSERT(false, "RegisterArray runtime index out of range");
+  // byte offset of register index is Offset + index * Stride
+  static constexpr std::span<std::byte, sizeof(reg_type)>
+  target(PackView<reg_pack> pack, std::size_t index) {
+    return std::span<std::byte, sizeof(reg_type)>{
+        pack.data() + Offset + index * Stride, sizeof(reg_type)};
   }
 };
 
-} // namespace regs
\ No newline at end of file
+} // namespace regs
@@ -2,25 +2,175 @@
 
 #include "Bytes.h"
 #include "Fields.h"
+#include "Trace.h"
 #include <algorithm>
+#include <array>
+#include <tuple>
 
 namespace regs {
 
+namespace details {
+
+/**
+ * @brief backend giving access to the register as one native word
+ *
+ * Such backends are accessed through load() and store() only, so every field
+ * operation becomes a single load or a single read-modify-write.
+ *
+ */
+template <typename T>
+concept word_accessible = requires(T &reg, typename T::reg_type value) {
+  { reg.load() } -> std::same_as<typename T::reg_type>;
+  reg.store(value);
+};
+
+/**
+ * @brief backend keeping a shadow copy of the register
+ *
+ * Field writes are read-modify-writes of the copy, so write_only fields can
+ * be written as well.
+ *
+ */
+template <typename T>
+concept is_shadow = requires { requires T::is_shadow; };
+
+/**
+ * @brief byte order of the register bytes, native unless the register
+ * declares byte_order
+ *
+ */
+template <typename T> constexpr std::endian byte_order_of() {
+  if constexpr (requires { T::byte_order; }) {
+    return T::byte_order;
+  } else {
+    return std::endian::native;
+  }
+}
+
+/**
+ * @brief value of T from its bytes stored in byte order Order
+ *
+ */
+template <typename T, std::endian Order, std::size_t Size>
+constexpr T from_bytes(const byte_array<Size> &bytes) {
+  static_assert(Size == sizeof(T), "size mismatch");
+  if constexpr (Order == std::endian::native) {
+    return std::bit_cast<T>(bytes);
+  } else {
+    using Word = uint_for_bytes_t<sizeof(T)>;
+    static_assert(!std::is_void_v<Word> && sizeof(Word) == sizeof(T),
+                  "byte swapped registers need a native word");
+    return std::bit_cast<T>(byteswap(std::bit_cast<Word>(bytes)));
+  }
+}
+
+/**
+ * @brief bytes of value stored in byte order Order
+ *
+ */
+template <std::endian Order, typename T>
+constexpr byte_array<sizeof(T)> to_bytes(T value) {
+  if constexpr (Order == std::endian::native) {
+    return std::bit_cast<byte_array<sizeof(T)>>(value);
+  } else {
+    using Word = uint_for_bytes_t<sizeof(T)>;
+    static_assert(!std::is_void_v<Word> && sizeof(Word) == sizeof(T),
+                  "byte swapped registers need a native word");
+    return std::bit_cast<byte_array<sizeof(T)>>(
+        byteswap(std::bit_cast<Word>(value)));
+  }
+}
+
+/**
+ * @brief backend updating the register atomically
+ *
+ * Read-modify-writes are handed to modify_word(f), which retries f until
+ * the register did not change in between.
+ *
+ */
+template <typename T>
+concept is_atomic = requires { requires T::is_atomic; };
+
+template <typename Reg, typename TField>
+concept is_field_of = std::same_as<Reg, typename TField::reg>;
+
+/**
+ * @brief true if none of the fields share a bit
+ *
+ */
+template <typename Word, typename... TFields>
+inline constexpr bool disjoint_fields =
+    (std::popcount(static_cast<Word>(TFields::word_mask)) + ...) ==
+    std::popcount(static_cast<Word>((TFields::word_mask | ...)));
+
+/**
+ * @brief register exactly one native word wide
+ *
+ */
+template <typename Reg>
+concept is_word_sized = requires {
+  requires !std::is_void_v<uint_for_bytes_t<Reg::size>>;
+  requires sizeof(uint_for_bytes_t<Reg::size>) == Reg::size;
+};
+
+/**
+ * @brief field holding plain bits, usable with set/clear/toggle/test
+ *
+ */
+template <typename TField>
+concept is_bit_field = std::integral<typename TField::value_type> ||
+                       std::is_enum_v<typename TField::value_type>;
+
+/**
+ * @brief all bits of a field set, as raw bits
+ *
+ */
+template <typename TField>
+inline constexpr std::uint64_t field_ones =
+    TField::field_width >= 64
+        ? ~std::uint64_t{0}
+        : (std::uint64_t{1} << TField::field_width) - 1;
+
+} // namespace details
+
 /**
  * @brief Register with bitfields
  *
  * @tparam reg_type underlying type
+ * @tparam Reg register the fields belong to, Derived unless Derived wraps
+ * another register
  */
-
-template <typename Derived, typename Reg_type> class RegisterBase {
+template <typename Derived, typename Reg_type, typename Reg = Derived>
+class RegisterBase {
 public:
   /**
    * @brief underlying access type
    *
    */
-  using reg = Derived;
+  using reg = Reg;
   using reg_type = Reg_type;
 
+  using word_type = uint_for_bytes_t<sizeof(reg_type)>;
+
+private:
+  template <typename Access>
+  static constexpr bool writeable =
+      details::is_writeable<Access> ||
+      (details::is_writeonly<Access> && details::is_shadow<Derived>);
+
+  /**
+   * @brief registers in foreign byte order are loaded as native word and
+   * swapped, field bits count from the least significant bit of the value
+   *
+   */
+  static constexpr bool swapped() {
+    return details::byte_order_of<Derived>() != std::endian::native;
+  }
+
+  static constexpr bool word_path() {
+    return details::word_accessible<Derived> || swapped();
+  }
+
 public:
   /**
    * @brief Field read
@@ -30,76 +180,548 @@ public:
    */
   template <typename TField>
     requires std::same_as<reg, typename TField::reg>
-  TField::value_type read() {
-    return TField::read(static_cast<Derived *>(this)->span());
+  constexpr TField::value_type read() {
+    typename TField::value_type value;
+    if constexpr (word_path()) {
+      static_assert(details::is_readable<typename TField::access>,
+                    "field is not readable");
+      value = TField::extract(load_word());
+    } else {
+      value = TField::read(static_cast<Derived *>(this)->span());
+    }
+    trace<TField>(trace_op::read, 0, value);
+    return value;
   }
 
   template <typename TArray, std::size_t Index>
     requires std::same_as<reg, typename TArray::reg>
-  typename TArray::value_type read() {
-    return TArray::template read<Index>(static_cast<Derived *>(this)->span());
+  constexpr typename TArray::value_type read() {
+    typename TArray::value_type value;
+    if constexpr (word_path()) {
+      static_assert(details::is_readable<typename TArray::access>,
+                    "field is not readable");
+      value = TArray::template field<Index>::extract(load_word());
+    } else {
+      value = TArray::template read<Index>(
+          static_cast<Derived *>(this)->span());
+    }
+    trace<TArray>(trace_op::read, Index, value);
+    return value;
   }
 
   template <typename TArray>
     requires std::same_as<reg, typename TArray::reg>
-  typename TArray::value_type read(std::size_t index) {
-    return TArray::read(static_cast<Derived *>(this)->span(), index);
+  constexpr typename TArray::value_type read(std::size_t index) {
+    typename TArray::value_type value;
+    if constexpr (word_path()) {
+      static_assert(details::is_readable<typename TArray::access>,
+                    "field is not readable");
+      value = TArray::extract(load_word(), index);
+    } else {
+      value = TArray::read(static_cast<Derived *>(this)->span(), index);
+    }
+    trace<TArray>(trace_op::read, index, value);
+    return value;
   }
 
-  template <typename TField>
-    requires std::same_as<reg, typename TField::reg>
-  void write(TField::value_type value) {
+  /**
+   * @brief read all fields of a FieldArray with one load
+   *
+   */
+  template <typename TArray>
+    requires std::same_as<reg, typename TArray::reg>
+  constexpr std::array<typename TArray::value_type, TArray::count> read_all() {
+    std::array<typename TArray::value_type, TArray::count> values;
+    if constexpr (word_path()) {
+      static_assert(details::is_readable<typename TArray::access>,
+                    "field is not readable");
+      values = TArray::extract_all(load_word());
+    } else {
+      values = TArray::read_all(static_cast<Derived *>(this)->span());
+    }
+    if constexpr (traced) {
+      for (std::size_t i = 0; i < TArray::count; i++) {
+        trace<TArray>(trace_op::read, i, values[i]);
+      }
+    }
+    return values;
+  }
 
-    TField::write(static_cast<Derived *>(this)->span(), value);
+  /**
+   * @brief call f(index, value) for all fields of a FieldArray, from one load
+   *
+   */
+  template <typename TArray, typename F>
+    requires std::same_as<reg, typename TArray::reg>
+  constexpr void for_each(F &&f) {
+    const auto values = read_all<TArray>();
+    for (std::size_t i = 0; i < TArray::count; i++) {
+      f(i, values[i]);
+    }
+  }
+
+  template <typename TField>
+    requires std::same_as<reg, typename TField::reg> &&
+             writeable<typename TField::access>
+  constexpr void write(TField::value_type value) {
+    if constexpr (word_path()) {
+      read_modify_write(
+          [&](word_type word) { return TField::insert(word, value); });
+    } else {
+      TField::write(static_cast<Derived *>(this)->span(), value);
+    }
+    trace<TField>(trace_op::write, 0, value);
   }
 
   template <typename TArray, std::size_t Index>
-    requires std::same_as<reg, typename TArray::reg>
-  void write(typename TArray::value_type value) {
-    TArray::template write<Index>(static_cast<Derived *>(this)->span(), value);
+    requires std::same_as<reg, typename TArray::reg> &&
+             writeable<typename TArray::access>
+  constexpr void write(typename TArray::value_type value) {
+    if constexpr (word_path()) {
+      read_modify_write([&](word_type word) {
+        return TArray::template field<Index>::insert(word, value);
+      });
+    } else {
+      TArray::template write<Index>(static_cast<Derived *>(this)->span(),
+                                    value);
+    }
+    trace<TArray>(trace_op::write, Index, value);
   }
 
   template <typename TArray>
-    requires std::same_as<reg, typename TArray::reg>
-  void write(std::size_t index, typename TArray::value_type value) {
-    TArray::write(static_cast<Derived *>(this)->span(), index, value);
+    requires std::same_as<reg, typename TArray::reg> &&
+             writeable<typename TArray::access>
+  constexpr void write(std::size_t index, typename TArray::value_type value) {
+    if constexpr (word_path()) {
+      read_modify_write([&](word_type word) {
+        return TArray::insert(word, index, value);
+      });
+    } else {
+      TArray::write(static_cast<Derived *>(this)->span(), index, value);
+    }
+    trace<TArray>(trace_op::write, index, value);
+  }
+
+  /**
+   * @brief write the fields of a FieldArray with one read-modify-write
+   *
+   */
+  template <typename TArray>
+    requires std::same_as<reg, typename TArray::reg> &&
+             writeable<typename TArray::access>
+  constexpr void write_all(std::span<const typename TArray::value_type> values) {
+    if constexpr (word_path()) {
+      read_modify_write(
+          [&](word_type word) { return TArray::insert_all(word, values); });
+    } else {
+      TArray::write_all(static_cast<Derived *>(this)->span(), values);
+    }
+    if constexpr (traced) {
+      for (std::size_t i = 0; i < values.size(); i++) {
+        trace<TArray>(trace_op::write, i, values[i]);
+      }
+    }
+  }
+
+  /**
+   * @brief set all fields of a FieldArray to value with one
+   * read-modify-write
+   *
+   */
+  template <typename TArray>
+    requires std::same_as<reg, typename TArray::reg> &&
+             writeable<typename TArray::access>
+  constexpr void fill(typename TArray::value_type value) {
+    if constexpr (word_path()) {
+      read_modify_write(
+          [&](word_type word) { return TArray::insert_fill(word, value); });
+    } else {
+      TArray::fill(static_cast<Derived *>(this)->span(), value);
+    }
+    if constexpr (traced) {
+      for (std::size_t i = 0; i < TArray::count; i++) {
+        trace<TArray>(trace_op::write, i, value);
+      }
+    }
   }
 
   template <typename TField, TField::value_type value>
-    requires std::same_as<reg, typename TField::reg>
-  void write() {
+    requires std::same_as<reg, typename TField::reg> &&
+             writeable<typename TField::access>
+  constexpr void write() {
     // static_assert(std::is_same_v<reg, typename TField::reg>, "invalid
     // Field");
-    TField::template write_constant<value>(
-        static_cast<Derived *>(this)->span());
+    if constexpr (word_path()) {
+      write<TField>(value);
+    } else {
+      TField::template write_constant<value>(
+          static_cast<Derived *>(this)->span());
+      trace<TField>(trace_op::write, 0, value);
+    }
   }
 
   template <typename TField, TField::value_type value>
     requires std::same_as<reg, typename TField::reg>
 
-  bool is() {
+  constexpr bool is() {
     //    static_assert(std::is_same_v<reg, typename TField::reg>, "invalid
     //    Field");
-    return TField::template is<value>(static_cast<Derived *>(this)->span());
+    if constexpr (word_path() || traced) {
+      return read<TField>() == value;
+    } else {
+      return TField::template is<value>(static_cast<Derived *>(this)->span());
+    }
   }
 
   template <typename TArray, std::size_t Index, typename TArray::value_type value>
     requires std::same_as<reg, typename TArray::reg>
-  bool is() {
-    return TArray::template is<Index, value>(
-        static_cast<Derived *>(this)->span());
+  constexpr bool is() {
+    if constexpr (word_path() || traced) {
+      return read<TArray, Index>() == value;
+    } else {
+      return TArray::template is<Index, value>(
+          static_cast<Derived *>(this)->span());
+    }
+  }
+
+  /**
+   * @brief write several fields with a single read-modify-write
+   *
+   * @tparam TFields fields of this register, must not overlap
+   * @param values one value per field
+   */
+  template <typename... TFields>
+    requires(sizeof...(TFields) > 0) &&
+            (details::is_field_of<reg, TFields> && ...) &&
+            (writeable<typename TFields::access> && ...)
+  constexpr void modify(typename TFields::value_type... values) {
+    static_assert(details::disjoint_fields<word_type, TFields...>,
+                  "fields overlap");
+
+    constexpr auto mask = static_cast<word_type>((TFields::word_mask | ...));
+
+    update(mask, static_cast<word_type>(
+                     (TFields::insert(word_type{0}, values) | ...)));
+    (trace<TFields>(trace_op::write, 0, values), ...);
+  }
+
+  /**
+   * @brief write several compile-time constants with a single
+   * read-modify-write, e.g. write<F1::Value<1>, F2::Value<2>>()
+   *
+   * @tparam TValues Field::Value instances
+   */
+  template <typename... TValues>
+    requires(sizeof...(TValues) > 0) &&
+            (details::is_field_value<TValues> && ...) &&
+            (details::is_field_of<reg, typename TValues::field> && ...) &&
+            (writeable<typename TValues::field::access> && ...)
+  constexpr void write() {
+    static_assert(
+        details::disjoint_fields<word_type, typename TValues::field...>,
+        "fields overlap");
+
+    constexpr auto mask =
+        static_cast<word_type>((TValues::field::word_mask | ...));
+    constexpr auto bits = static_cast<word_type>(
+        (TValues::field::insert(word_type{0}, TValues::value) | ...));
+
+    update(mask, bits);
+    (trace<typename TValues::field>(trace_op::write, 0, TValues::value), ...);
+  }
+
+  /**
+   * @brief set all bits of one or more fields with a single
+   * read-modify-write, e.g. set<Irq::Rx, Irq::Tx>()
+   *
+   * A single field of a register without native word backend only touches
+   * the bytes of the field, a single bit field is one OR on its byte.
+   *
+   */
+  template <typename... TFields>
+    requires(sizeof...(TFields) > 0) &&
+            (details::is_field_of<reg, TFields> && ...) &&
+            (details::is_bit_field<TFields> && ...) &&
+            (writeable<typename TFields::access> && ...)
+  constexpr void set() {
+    modify_bits<bit_op::set, TFields...>();
+  }
+
+  /**
+   * @brief clear all bits of one or more fields with a single
+   * read-modify-write
+   *
+   */
+  template <typename... TFields>
+    requires(sizeof...(TFields) > 0) &&
+            (details::is_field_of<reg, TFields> && ...) &&
+            (details::is_bit_field<TFields> && ...) &&
+            (writeable<typename TFields::access> && ...)
+  constexpr void clear() {
+    modify_bits<bit_op::clear, TFields...>();
+  }
+
+  /**
+   * @brief invert all bits of one or more fields with a single
+   * read-modify-write
+   *
+   */
+  template <typename... TFields>
+    requires(sizeof...(TFields) > 0) &&
+            (details::is_field_of<reg, TFields> && ...) &&
+            (details::is_bit_field<TFields> && ...) &&
+            (writeable<typename TFields::access> && ...)
+  constexpr void toggle() {
+    modify_bits<bit_op::toggle, TFields...>();
   }
 
-  reg_type read() {
-    return std::bit_cast<reg_type>(static_cast<Derived *>(this)->const_target());
+  /**
+   * @brief true if all bits of all fields are set, from a single load
+   *
+   */
+  template <typename... TFields>
+    requires(sizeof...(TFields) > 0) &&
+            (details::is_field_of<reg, TFields> && ...) &&
+            (details::is_bit_field<TFields> && ...) &&
+            (details::is_readable<typename TFields::access> && ...)
+  constexpr bool test() {
+    bool result;
+    if constexpr (word_bits<TFields...>()) {
+      constexpr auto mask = static_cast<word_type>((TFields::word_mask | ...));
+      result = static_cast<word_type>(load_word() & mask) == mask;
+    } else {
+      const auto target = static_cast<Derived *>(this)->span();
+      result = (TFields::test(target) && ...);
+    }
+    (trace<TFields>(trace_op::read, 0, result), ...);
+    return result;
   }
 
-  void write(reg_type value) {
-    auto bytes = std::bit_cast<byte_array<sizeof(reg_type)>>(value);
-    auto target = static_cast<Derived *>(this)->span();
-    std::copy(bytes.begin(), bytes.end(), target.begin());
+  /**
+   * @brief read several fields from a single load of the register
+   *
+   * @tparam TFields fields of this register
+   * @return std::tuple with one value per field
+   */
+  template <typename... TFields>
+    requires(sizeof...(TFields) > 0) &&
+            (details::is_field_of<reg, TFields> && ...) &&
+            (details::is_readable<typename TFields::access> && ...)
+  constexpr std::tuple<typename TFields::value_type...> read_fields() {
+    if constexpr (traced) {
+      auto values = read_fields_untraced<TFields...>();
+      std::apply(
+          [&](const auto &...value) {
+            (trace<TFields>(trace_op::read, 0, value), ...);
+          },
+          values);
+      return values;
+    } else {
+      return read_fields_untraced<TFields...>();
+    }
   }
 
+  constexpr reg_type read() {
+    reg_type value;
+    if constexpr (details::word_accessible<Derived>) {
+      value = static_cast<Derived *>(this)->load();
+    } else if constexpr (swapped()) {
+      value = std::bit_cast<reg_type>(load_word());
+    } else {
+      value = std::bit_cast<reg_type>(
+          static_cast<Derived *>(this)->const_target());
+    }
+    trace<reg>(trace_op::read, 0, value);
+    return value;
+  }
+
+  constexpr void write(reg_type value) {
+    if constexpr (details::word_accessible<Derived>) {
+      static_cast<Derived *>(this)->store(value);
+    } else if constexpr (swapped()) {
+      store_word(std::bit_cast<word_type>(value));
+    } else {
+      auto bytes = std::bit_cast<byte_array<sizeof(reg_type)>>(value);
+      auto target = static_cast<Derived *>(this)->span();
+      std::copy(bytes.begin(), bytes.end(), target.begin());
+    }
+    trace<reg>(trace_op::write, 0, value);
+  }
+
+  /**
+   * @brief register value with every field at its reset value, taken from
+   * the FieldMap the register declares as field_map, zero without one
+   *
+   */
+  static constexpr reg_type reset_value() {
+    if constexpr (requires { typename reg::field_map; }) {
+      static_assert(std::same_as<reg, typename reg::field_map::reg>,
+                    "field map of another register");
+      return std::bit_cast<reg_type>(reg::field_map::reset_bytes);
+    } else {
+      return std::bit_cast<reg_type>(byte_array<sizeof(reg_type)>{});
+    }
+  }
+
+  /**
+   * @brief write the reset value with a single store
+   *
+   */
+  constexpr void reset() { write(reset_value()); }
+
+  /**
+   * @brief write the reset value with some fields replaced by constants,
+   * folded at compile time into a single store
+   *
+   * @tparam TValues Field::Value of fields of this register
+   */
+  template <typename... TValues>
+    requires(details::is_field_value<TValues> && ...) &&
+            (std::same_as<reg, typename TValues::field::reg> && ...)
+  constexpr void init() {
+    static_assert(details::is_word_sized<Derived>,
+                  "register is not a native word");
+    static_assert((writeable<typename TValues::field::access> && ...),
+                  "field is not writeable");
+
+    constexpr auto word = [] {
+      auto bits = std::bit_cast<word_type>(reset_value());
+      ((bits = TValues::field::insert(bits, TValues::value)), ...);
+      return bits;
+    }();
+    write(std::bit_cast<reg_type>(word));
+  }
+
+protected:
+  static constexpr bool traced = trace_policy<reg>::type::enabled;
+
+  /**
+   * @brief hand an access to the tracing policy of the register, no code
+   * without tracing
+   *
+   */
+  template <typename TField, typename Value>
+  constexpr void trace([[maybe_unused]] trace_op op,
+                       [[maybe_unused]] std::size_t index,
+                       [[maybe_unused]] const Value &value) {
+    if constexpr (traced) {
+      if (!std::is_constant_evaluated()) {
+        trace_policy<reg>::type::template record<reg, TField>(
+            op, static_cast<Derived *>(this), index, value);
+      }
+    }
+  }
+
+private:
+  enum class bit_op { set, clear, toggle };
+
+  /**
+   * @brief true if set/clear/toggle/test of TFields go through the native
+   * word, otherwise every field is changed on its own bytes
+   *
+   */
+  template <typename... TFields> static constexpr bool word_bits() {
+    return word_path() ||
+           (sizeof...(TFields) > 1 && !std::is_void_v<word_type>);
+  }
+
+  template <bit_op Op, typename... TFields> constexpr void modify_bits() {
+    if constexpr (word_bits<TFields...>()) {
+      static_assert(details::disjoint_fields<word_type, TFields...>,
+                    "fields overlap");
+
+      constexpr auto mask = static_cast<word_type>((TFields::word_mask | ...));
+
+      read_modify_write([](word_type word) {
+        if constexpr (Op == bit_op::set) {
+          return static_cast<word_type>(word | mask);
+        } else if constexpr (Op == bit_op::clear) {
+          return static_cast<word_type>(word & ~mask);
+        } else {
+          return static_cast<word_type>(word ^ mask);
+        }
+      });
+    } else {
+      const auto target = static_cast<Derived *>(this)->span();
+      if constexpr (Op == bit_op::set) {
+        (TFields::set(target), ...);
+      } else if constexpr (Op == bit_op::clear) {
+        (TFields::clear(target), ...);
+      } else {
+        (TFields::toggle(target), ...);
+      }
+    }
+
+    // set and toggle record the changed bits, clear records 0
+    (trace<TFields>(trace_op::write, 0,
+                    Op == bit_op::clear ? std::uint64_t{0}
+                                        : details::field_ones<TFields>),
+     ...);
+  }
+
+  template <typename... TFields>
+  constexpr std::tuple<typename TFields::value_type...> read_fields_untraced() {
+    if constexpr (word_path() ||
+                  (!std::is_void_v<word_type> &&
+                   ((std::integral<typename TFields::value_type> ||
+                     std::is_enum_v<typename TFields::value_type>) &&
+                    ...))) {
+      const auto word = load_word();
+      return {TFields::extract(word)...};
+    } else {
+      const auto snapshot = to_byte_array<sizeof(reg_type)>(
+          static_cast<Derived *>(this)->span());
+      return {TFields::read(std::span<const std::byte>{snapshot})...};
+    }
+  }
+
+  template <typename Word = word_type> constexpr Word load_word() {
+    if constexpr (details::word_accessible<Derived>) {
+      return std::bit_cast<Word>(static_cast<Derived *>(this)->load());
+    } else if constexpr (swapped()) {
+      static_assert(sizeof(Word) == sizeof(reg_type),
+                    "byte swapped registers need a native word");
+      return regs::byteswap(
+          regs::load_word<Word>(static_cast<Derived *>(this)->span().data()));
+    } else {
+      return regs::load_word<Word, sizeof(reg_type)>(
+          static_cast<Derived *>(this)->span().data());
+    }
+  }
+
+  template <typename Word> constexpr void store_word(Word word) {
+    if constexpr (details::word_accessible<Derived>) {
+      static_cast<Derived *>(this)->store(std::bit_cast<reg_type>(word));
+    } else if constexpr (swapped()) {
+      static_assert(sizeof(Word) == sizeof(reg_type),
+                    "byte swapped registers need a native word");
+      regs::store_word<sizeof(Word)>(
+          static_cast<Derived *>(this)->span().data(), regs::byteswap(word));
+    } else {
+      regs::store_word<sizeof(reg_type)>(
+          static_cast<Derived *>(this)->span().data(), word);
+    }
+  }
+
+  /**
+   * @brief store f(word) of the loaded word, atomic registers retry until
+   * no other writer interfered
+   *
+   */
+  template <typename F> constexpr void read_modify_write(F &&f) {
+    if constexpr (details::is_atomic<Derived>) {
+      static_cast<Derived *>(this)->modify_word(f);
+    } else {
+      store_word(f(load_word()));
+    }
+  }
+
+  template <typename Word> constexpr void update(Word mask, Word bits) {
+    static_assert(!std::is_void_v<word_type>,
+                  "register is wider than a native word");
+    read_modify_write(
+        [&](Word word) { return static_cast<Word>((word & ~mask) | bits); });
+  }
 };
 
 } // namespace regs
\ No newline at end of file
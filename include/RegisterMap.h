@@ -0,0 +1,322 @@
+#pragma once
+
+#include "PackView.h"
+#include "RegisterBase.h"
+#include "TypeName.h"
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace regs {
+
+/**
+ * @brief access of a field as runtime value
+ *
+ */
+enum class access_kind { read_only, read_write, write_only };
+
+/**
+ * @brief layout of one field, bit offset and width within the register
+ *
+ */
+struct field_info {
+  std::string_view name;
+  unsigned offset;
+  unsigned width;
+  access_kind access;
+};
+
+/**
+ * @brief layout of one register or register array, byte offset and size
+ * within the pack
+ *
+ */
+struct register_info {
+  std::string_view name;
+  std::size_t offset;
+  std::size_t size;
+};
+
+namespace details {
+
+template <typename Access> constexpr access_kind access_of() {
+  if constexpr (std::is_same_v<Access, read_write>) {
+    return access_kind::read_write;
+  } else if constexpr (is_writeonly<Access>) {
+    return access_kind::write_only;
+  } else {
+    return access_kind::read_only;
+  }
+}
+
+template <typename T>
+concept is_field_array = requires {
+  T::count;
+  typename T::template field<0>;
+};
+
+/**
+ * @brief half open range [begin, end)
+ *
+ */
+struct extent {
+  std::size_t begin;
+  std::size_t end;
+};
+
+/**
+ * @brief bits covered by a Field, or by every field of a FieldArray
+ *
+ */
+template <typename T> constexpr auto bit_extents() {
+  if constexpr (is_field_array<T>) {
+    return []<std::size_t... Index>(std::index_sequence<Index...>) {
+      return std::array<extent, T::count>{
+          extent{T::template field<Index>::shift,
+                 T::template field<Index>::shift +
+                     T::template field<Index>::field_width}...};
+    }(std::make_index_sequence<T::count>{});
+  } else {
+    return std::array<extent, 1>{extent{T::shift, T::shift + T::field_width}};
+  }
+}
+
+/**
+ * @brief bytes covered by a PackedRegister or RegisterArray
+ *
+ */
+template <typename T> constexpr auto byte_extents() {
+  return std::array<extent, 1>{extent{T::offset, T::offset + T::size}};
+}
+
+/**
+ * @brief true if no two of the extents overlap
+ *
+ */
+template <std::size_t... Sizes>
+constexpr bool disjoint(const std::array<extent, Sizes> &...lists) {
+  constexpr std::size_t total = (Sizes + ... + 0);
+  std::array<extent, total> all{};
+
+  std::size_t n = 0;
+  ((
+       [&] {
+         for (const auto &e : lists) {
+           all[n++] = e;
+         }
+       }()),
+   ...);
+
+  for (std::size_t i = 0; i < total; i++) {
+    for (std::size_t j = i + 1; j < total; j++) {
+      if (all[i].begin < all[j].end && all[j].begin < all[i].end) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+template <typename... TFields>
+inline constexpr bool fields_disjoint = disjoint(bit_extents<TFields>()...);
+
+template <typename... TRegs>
+inline constexpr bool registers_disjoint = disjoint(byte_extents<TRegs>()...);
+
+template <typename T>
+concept is_register_array = requires {
+  T::count;
+  typename T::template reg<0>;
+};
+
+/**
+ * @brief word with the reset value of a Field, or of every field of a
+ * FieldArray, inserted
+ *
+ */
+template <typename T, typename Word> constexpr Word insert_reset(Word word) {
+  if constexpr (is_field_array<T>) {
+    return T::insert_fill(word, T::reset_value);
+  } else {
+    return T::insert(word, T::reset_value);
+  }
+}
+
+/**
+ * @brief write the reset value of a Field, or of every field of a
+ * FieldArray, into the bytes of a register without native word
+ *
+ */
+template <typename T, std::size_t Size>
+constexpr void write_reset(byte_array<Size> &bytes) {
+  if constexpr (is_field_array<T>) {
+    [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+      (write_reset<typename T::template field<Index>>(bytes), ...);
+    }(std::make_index_sequence<T::count>{});
+  } else {
+    static_assert(std::integral<typename T::value_type> ||
+                      std::is_enum_v<typename T::value_type>,
+                  "reset values of registers without native word must be "
+                  "integral or enum");
+    T::write_masked(bytes, T::reset_value);
+  }
+}
+
+/**
+ * @brief copy the reset value of a PackedRegister, or of every register of a
+ * RegisterArray, into the bytes of its pack
+ *
+ */
+template <typename T, std::size_t Size>
+constexpr void put_reset(byte_array<Size> &image) {
+  if constexpr (is_register_array<T>) {
+    [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+      (put_reset<typename T::template reg<Index>>(image), ...);
+    }(std::make_index_sequence<T::count>{});
+  } else {
+    const auto bytes = to_bytes<byte_order_of<T>()>(T::reset_value());
+    std::copy(bytes.begin(), bytes.end(), image.begin() + T::offset);
+  }
+}
+
+template <typename T> constexpr field_info make_field_info() {
+  if constexpr (is_field_array<T>) {
+    using first = typename T::template field<0>;
+    using last = typename T::template field<T::count - 1>;
+    return {type_name<T>(), first::shift, last::shift + last::field_width - first::shift,
+            access_of<typename first::access>()};
+  } else {
+    return {type_name<T>(), T::shift, T::field_width,
+            access_of<typename T::access>()};
+  }
+}
+
+} // namespace details
+
+/**
+ * @brief compile-time description of the fields of a register
+ *
+ * Checks that all fields belong to Reg and that no two fields share a bit.
+ * FieldArrays are listed as one entry spanning all of their fields.
+ *
+ * A register declaring its map as `using field_map = FieldMap<...>` gets
+ * reset_value(), reset() and init() from the reset values of the fields.
+ *
+ * @tparam Reg register
+ * @tparam TFields Fields and FieldArrays of Reg
+ */
+template <typename Reg, typename... TFields> struct FieldMap {
+  using reg = Reg;
+  using fields_list = std::tuple<TFields...>;
+
+  static constexpr std::size_t count = sizeof...(TFields);
+
+  static_assert((std::is_same_v<Reg, typename TFields::reg> && ...),
+                "field of another register");
+  static_assert(details::fields_disjoint<TFields...>, "fields overlap");
+
+  static constexpr std::string_view name = details::type_name<Reg>();
+
+  static constexpr std::array<field_info, count> fields = {
+      details::make_field_info<TFields>()...};
+
+  /**
+   * @brief bytes of the register value with every field at its reset value,
+   * bits no field covers are zero
+   *
+   */
+  static constexpr auto reset_bytes = [] {
+    using reg_type = typename Reg::reg_type;
+
+    if constexpr (details::is_word_sized<Reg>) {
+      uint_for_bytes_t<sizeof(reg_type)> word{0};
+      ((word = details::insert_reset<TFields>(word)), ...);
+      return std::bit_cast<byte_array<sizeof(reg_type)>>(word);
+    } else {
+      byte_array<sizeof(reg_type)> bytes{};
+      (details::write_reset<TFields>(bytes), ...);
+      return bytes;
+    }
+  }();
+
+  /**
+   * @brief call f(std::type_identity<Field>{}, info) for every field
+   *
+   */
+  template <typename F> static constexpr void for_each(F &&f) {
+    std::size_t index = 0;
+    (f(std::type_identity<TFields>{}, fields[index++]), ...);
+  }
+};
+
+/**
+ * @brief compile-time description of the registers of a pack
+ *
+ * Checks that all registers belong to Pack, lie within the pack and that no
+ * two registers share a byte.
+ *
+ * @tparam Pack RegisterPack
+ * @tparam TRegs PackedRegisters and RegisterArrays of Pack
+ */
+template <typename Pack, typename... TRegs> struct RegisterMap {
+  using pack = Pack;
+  using registers_list = std::tuple<TRegs...>;
+
+  static constexpr std::size_t count = sizeof...(TRegs);
+
+  static constexpr std::size_t pack_size =
+      sizeof(typename Pack::target_type);
+
+  static_assert((std::is_same_v<Pack, typename TRegs::reg_pack> && ...),
+                "register of another pack");
+  static_assert(((TRegs::offset + TRegs::size <= pack_size) && ...),
+                "register exceeds pack");
+  static_assert(details::registers_disjoint<TRegs...>, "registers overlap");
+
+  static constexpr std::string_view name = details::type_name<Pack>();
+
+  static constexpr std::array<register_info, count> registers = {
+      register_info{details::type_name<TRegs>(), TRegs::offset,
+                    TRegs::size}...};
+
+  /**
+   * @brief number of bytes of the pack no register covers
+   *
+   */
+  static constexpr std::size_t unmapped = pack_size - (TRegs::size + ... + 0);
+
+  /**
+   * @brief pack bytes with every register at its reset value, bytes no
+   * register covers are zero
+   *
+   */
+  static constexpr byte_array<pack_size> reset_image = [] {
+    byte_array<pack_size> image{};
+    (details::put_reset<TRegs>(image), ...);
+    return image;
+  }();
+
+  /**
+   * @brief bring every register of the pack to its reset value with one
+   * copy of reset_image
+   *
+   */
+  static void reset_all(PackView<Pack> pack) {
+    std::memcpy(pack.data(), reset_image.data(), pack_size);
+  }
+
+  /**
+   * @brief call f(std::type_identity<Reg>{}, info) for every register
+   *
+   */
+  template <typename F> static constexpr void for_each(F &&f) {
+    std::size_t index = 0;
+    (f(std::type_identity<TRegs>{}, registers[index++]), ...);
+  }
+};
+
+} // namespace regs
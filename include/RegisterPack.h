@@ -1,11 +1,14 @@
 #pragma once
 
+#include "PackDelta.h"
+#include "PackView.h"
 #include "Register.h"
 #include "RegisterBase.h"
 
 namespace regs {
 
-template <typename RegPack, typename Reg, unsigned Offset, typename Reg_type>
+template <typename RegPack, typename Reg, unsigned Offset, typename Reg_type,
+          std::endian Order = std::endian::native>
 class PackedRegister : public RegisterBase<Reg, Reg_type> {
  public:
 
@@ -13,39 +16,65 @@ class PackedRegister : public RegisterBase<Reg, Reg_type> {
  using reg_pack = RegPack;
  using reg_type = Reg_type;
 
+ static constexpr std::endian byte_order = Order;
+
  static constexpr size_t size = sizeof(reg_type); 
 
+ static constexpr unsigned offset = Offset;
+
  using target_type = byte_array<size>;
 
 
  private:
 
- reg_pack& _pack;
+ // first byte of the pack
+ std::byte *_bytes;
 
 
 
   public:
 
     /**
-   * @brief Default constructor with initialization
+   * @brief register of an owning pack
+   *
+   */
+  constexpr PackedRegister(reg_pack &pack) : _bytes(pack._target.data()) {}
+
+  /**
+   * @brief register of a pack viewed over a buffer
    *
    */
-  constexpr PackedRegister(reg_pack &pack) : _pack(pack) {}
-  
+  template <std::size_t Extent>
+  constexpr PackedRegister(PackView<reg_pack, Extent> view)
+      : _bytes(view.data()) {}
 
-  auto span(){
-    return std::span{_pack._target.begin() + Offset, sizeof(reg_type)};
+  constexpr auto span(){
+    return std::span<std::byte, size>{_bytes + Offset, size};
   }
 
-  target_type const_target() const {
+  constexpr target_type const_target() const {
 
     target_type res;
 
-    std::copy(_pack._target.begin() + Offset, _pack._target.begin() + Offset + size, res.begin());
+    std::copy(_bytes + Offset, _bytes + Offset + size, res.begin());
 
     return res; 
      
      }
+
+  /**
+   * @brief read the register straight from the bytes of a pack, without a
+   * pack object
+   *
+   * @param pack_bytes bytes of the whole pack
+   * @return reg_type
+   */
+  static constexpr reg_type decode(std::span<const std::byte> pack_bytes) {
+    ESCAD_ASSERT(pack_bytes.size() >= Offset + size,
+                 "pack too short for register");
+    return details::from_bytes<reg_type, Order>(
+        to_byte_array<size>(pack_bytes.subspan(Offset, size)));
+  }
 };
 
 template <size_t size> class RegisterPack {
@@ -61,20 +90,51 @@ public:
    * @brief Default constructor with initialization
    *
    */
-  explicit RegisterPack() : _target() {}
+  constexpr explicit RegisterPack() : _target() {}
 
   /**
    * @brief Tagged constructor without initialization, to be used with placement
    * new
    *
    */
-  explicit RegisterPack(noInit) {}
+  constexpr explicit RegisterPack(noInit) {}
 
-  auto span() { return std::span{_target}; }
+  constexpr auto span() { return std::span{_target}; }
 
-  
+  /**
+   * @brief copy of the whole pack
+   *
+   */
+  constexpr target_type snapshot() const { return _target; }
+
+  /**
+   * @brief bytes of b that differ from a
+   *
+   * @param delta cleared and filled, reusing its buffers
+   */
+  static void diff(const target_type &a, const target_type &b,
+                   PackDelta &delta) {
+    delta.clear();
+    details::diff_bytes(a.data(), b.data(), size, delta);
+  }
 
+  static PackDelta diff(const target_type &a, const target_type &b) {
+    PackDelta delta;
+    diff(a, b, delta);
+    return delta;
+  }
 
+  /**
+   * @brief write the ranges of a delta into the pack, other bytes are left
+   * as they are
+   *
+   */
+  void apply(const PackDelta &delta) {
+    delta.for_each([this](std::size_t offset, std::span<const std::byte> bytes) {
+      ESCAD_ASSERT(offset + bytes.size() <= size, "delta exceeds pack");
+      std::memcpy(_target.data() + offset, bytes.data(), bytes.size());
+    });
+  }
 
 };
 } // namespace regs
\ No newline at end of file
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "RegisterPack.h"
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+#if __has_include(<sys/uio.h>)
+#include <sys/uio.h>
+#define REGS_HAS_IOVEC 1
+#endif
+
+namespace regs {
+
+namespace details {
+
+inline std::span<const std::byte>
+segment_bytes(std::span<const std::byte> segment) {
+  return segment;
+}
+
+#if defined(REGS_HAS_IOVEC)
+inline std::span<const std::byte> segment_bytes(const iovec &segment) {
+  return {static_cast<const std::byte *>(segment.iov_base), segment.iov_len};
+}
+#endif
+
+} // namespace details
+
+/**
+ * @brief Read-only view of a RegisterPack whose bytes are split over several
+ * segments, e.g. the buffers of a scatter/gather receive
+ *
+ * Registers lying inside one segment are loaded with a single copy of their
+ * bytes, only registers straddling a segment boundary are stitched together
+ * byte range by byte range. Fields are extracted from their register as
+ * usual, so the frame never has to be copied into a contiguous buffer.
+ *
+ * Segments are looked up by a linear scan, which suits the handful of
+ * buffers a packet is usually split into.
+ *
+ * @tparam Pack RegisterPack laid over the segments
+ * @tparam Segment std::span<const std::byte> or iovec
+ */
+template <typename Pack, typename Segment = std::span<const std::byte>>
+class SegmentedPack {
+ public:
+
+ static constexpr std::size_t pack_size = sizeof(typename Pack::target_type);
+
+ private:
+
+ std::span<const Segment> _segments;
+
+ // offset of the pack within the concatenated segments
+ std::size_t _offset = 0;
+
+  public:
+
+  /**
+   * @param segments buffers in order, empty ones are allowed
+   * @param offset position of the pack within the concatenated segments
+   */
+  explicit SegmentedPack(std::span<const Segment> segments,
+                         std::size_t offset = 0)
+      : _segments(segments), _offset(offset) {
+    ESCAD_ASSERT(_offset + pack_size <= total_size(),
+                 "segments too short for pack");
+  }
+
+  /**
+   * @brief number of bytes of all segments
+   *
+   */
+  std::size_t total_size() const {
+    std::size_t size = 0;
+    for (const auto &segment : _segments) {
+      size += details::segment_bytes(segment).size();
+    }
+    return size;
+  }
+
+  /**
+   * @brief another pack starting offset bytes behind this one, e.g. the TLV
+   * following a frame header
+   *
+   */
+  template <typename Other>
+  SegmentedPack<Other, Segment> overlay(std::size_t offset) const {
+    return SegmentedPack<Other, Segment>{_segments, _offset + offset};
+  }
+
+  /**
+   * @brief pointer to the bytes [offset, offset + length) of the pack if
+   * they lie in one segment, nullptr if they straddle a boundary
+   *
+   */
+  const std::byte *contiguous(std::size_t offset, std::size_t length) const {
+    auto position = _offset + offset;
+    for (const auto &segment : _segments) {
+      const auto bytes = details::segment_bytes(segment);
+      if (position < bytes.size()) {
+        return position + length <= bytes.size() ? bytes.data() + position
+                                                 : nullptr;
+      }
+      position -= bytes.size();
+    }
+    return nullptr;
+  }
+
+  /**
+   * @brief copy the bytes [offset, offset + target.size()) of the pack to
+   * target, across segment boundaries
+   *
+   */
+  void copy_to(std::span<std::byte> target, std::size_t offset = 0) const {
+    ESCAD_ASSERT(offset + target.size() <= pack_size, "range exceeds pack");
+
+    auto position = _offset + offset;
+    auto *out = target.data();
+    auto remaining = target.size();
+
+    for (const auto &segment : _segments) {
+      if (remaining == 0) {
+        break;
+      }
+      const auto bytes = details::segment_bytes(segment);
+      if (position >= bytes.size()) {
+        position -= bytes.size();
+        continue;
+      }
+
+      const auto count = std::min(remaining, bytes.size() - position);
+      std::memcpy(out, bytes.data() + position, count);
+      out += count;
+      remaining -= count;
+      position = 0;
+    }
+  }
+
+  /**
+   * @brief read a PackedRegister of Pack
+   *
+   */
+  template <typename Reg>
+    requires std::same_as<Pack, typename Reg::reg_pack>
+  typename Reg::reg_type decode() const {
+    return details::from_bytes<typename Reg::reg_type,
+                               details::byte_order_of<Reg>()>(
+        register_bytes<Reg>());
+  }
+
+  /**
+   * @brief read a field of a PackedRegister of Pack
+   *
+   */
+  template <typename TField>
+    requires std::same_as<Pack, typename TField::reg::reg_pack>
+  typename TField::value_type read() const {
+    const auto bytes = register_bytes<typename TField::reg>();
+    return details::read_field<TField>(bytes);
+  }
+
+  /**
+   * @brief read field index of a FieldArray of a PackedRegister of Pack
+   *
+   */
+  template <typename TArray>
+    requires std::same_as<Pack, typename TArray::reg::reg_pack>
+  typename TArray::value_type read(std::size_t index) const {
+    const auto bytes = register_bytes<typename TArray::reg>();
+    return details::read_field<TArray>(bytes, index);
+  }
+
+ private:
+
+  template <typename Reg> byte_array<Reg::size> register_bytes() const {
+    byte_array<Reg::size> bytes;
+    if (const auto *data = contiguous(Reg::offset, Reg::size)) {
+      std::memcpy(bytes.data(), data, Reg::size);
+    } else {
+      copy_to(bytes, Reg::offset);
+    }
+    return bytes;
+  }
+};
+
+} // namespace regs
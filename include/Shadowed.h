@@ -0,0 +1,207 @@
+#pragma once
+
+#include "RegisterBase.h"
+#include "RegisterPack.h"
+#include <cstring>
+#include <type_traits>
+
+namespace regs {
+
+namespace details {
+
+template <typename T>
+concept is_packed_register = requires { typename T::reg_pack; };
+
+} // namespace details
+
+/**
+ * @brief Register with an in-memory shadow copy
+ *
+ * Field reads and writes work on the shadow only, the device register is
+ * written on flush() and only if the shadow changed. Since the shadow is
+ * always readable, write_only fields can be written with read-modify-write.
+ *
+ * @tparam Reg Register, PackedRegister or MmioRegister to shadow
+ */
+template <typename Reg>
+class Shadowed : public RegisterBase<Shadowed<Reg>, typename Reg::reg_type,
+                                     typename Reg::reg> {
+ public:
+
+ using reg = typename Reg::reg;
+ using reg_type = typename Reg::reg_type;
+
+ using target_type = typename Reg::target_type;
+
+ static constexpr bool is_shadow = true;
+
+ static_assert(!std::is_void_v<uint_for_bytes_t<sizeof(reg_type)>>,
+               "register is wider than a native word");
+
+ /**
+  * @brief PackedRegisters are handles and kept by value, all other registers
+  * by reference
+  *
+  */
+ using device_type =
+     std::conditional_t<details::is_packed_register<Reg>, Reg, Reg &>;
+
+ private:
+
+ device_type _device;
+
+ reg_type _shadow;
+
+ bool _dirty = false;
+
+  public:
+
+  /**
+   * @brief Shadow initialized from the device register
+   *
+   */
+  explicit Shadowed(device_type device)
+      : _device(device), _shadow(_device.read()) {}
+
+  /**
+   * @brief Shadow initialized from a known value, the device is not read,
+   * to be used with write-only registers
+   *
+   */
+  Shadowed(device_type device, reg_type initial)
+      : _device(device), _shadow(initial) {}
+
+  reg_type load() const { return _shadow; }
+
+  void store(reg_type value) {
+    _shadow = value;
+    _dirty = true;
+  }
+
+  bool dirty() const { return _dirty; }
+
+  /**
+   * @brief write the shadow to the device if it changed
+   *
+   * @return true if the device was written
+   */
+  bool flush() {
+    if (!_dirty) {
+      return false;
+    }
+
+    _device.write(_shadow);
+    _dirty = false;
+
+    return true;
+  }
+
+  /**
+   * @brief reload the shadow from the device, dropping pending writes
+   *
+   */
+  void pull() {
+    _shadow = _device.read();
+    _dirty = false;
+  }
+
+  Reg &device() { return _device; }
+};
+
+/**
+ * @brief RegisterPack with an in-memory shadow copy
+ *
+ * The ShadowedPack is itself a Pack, so PackedRegisters and RegisterArrays
+ * bound to it work on the shadow. flush_dirty() compares the shadow against
+ * the content last written to the device and writes back only the words that
+ * changed.
+ *
+ * @tparam Pack RegisterPack to shadow
+ * @tparam Word granularity of the write back
+ */
+template <typename Pack, typename Word = std::uint32_t>
+class ShadowedPack : public Pack {
+ public:
+
+ using target_type = typename Pack::target_type;
+
+ static constexpr std::size_t size = sizeof(target_type);
+
+ static constexpr std::size_t word_count = size / sizeof(Word);
+
+ private:
+
+ Pack &_device;
+
+ target_type _committed;
+
+  public:
+
+  explicit ShadowedPack(Pack &device)
+      : Pack(device), _device(device), _committed(device._target) {}
+
+  /**
+   * @brief true if any byte of the register differs from the device
+   *
+   * @tparam Reg PackedRegister of Pack
+   */
+  template <typename Reg> bool dirty() const {
+    constexpr auto offset = Reg::offset;
+    return std::memcmp(this->_target.data() + offset,
+                       _committed.data() + offset, Reg::size) != 0;
+  }
+
+  bool dirty() const {
+    return std::memcmp(this->_target.data(), _committed.data(), size) != 0;
+  }
+
+  /**
+   * @brief write every changed word of the shadow to the device
+   *
+   * @return number of words written
+   */
+  std::size_t flush_dirty() {
+    std::size_t written = 0;
+
+    auto *shadow = this->_target.data();
+    auto *committed = _committed.data();
+    auto *device = _device._target.data();
+
+    for (std::size_t i = 0; i < word_count; i++) {
+      const auto offset = i * sizeof(Word);
+
+      if (load_word<Word>(shadow + offset) !=
+          load_word<Word>(committed + offset)) {
+        std::memcpy(device + offset, shadow + offset, sizeof(Word));
+        std::memcpy(committed + offset, shadow + offset, sizeof(Word));
+        written++;
+      }
+    }
+
+    constexpr auto tail = size % sizeof(Word);
+    if constexpr (tail != 0) {
+      const auto offset = word_count * sizeof(Word);
+
+      if (std::memcmp(shadow + offset, committed + offset, tail) != 0) {
+        std::memcpy(device + offset, shadow + offset, tail);
+        std::memcpy(committed + offset, shadow + offset, tail);
+        written++;
+      }
+    }
+
+    return written;
+  }
+
+  /**
+   * @brief reload the shadow from the device, dropping pending writes
+   *
+   */
+  void pull() {
+    this->_target = _device._target;
+    _committed = _device._target;
+  }
+
+  Pack &device() { return _device; }
+};
+
+} // namespace regs
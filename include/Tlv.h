@@ -0,0 +1,204 @@
+#pragma once
+
+#include "RegisterPack.h"
+#include <cstddef>
+#include <iterator>
+#include <span>
+
+namespace regs {
+
+/**
+ * @brief Associates a TLV type value with the RegisterPack laid over its
+ * payload, used with TlvRange::dispatch
+ *
+ * @tparam Type type value of the TLV
+ * @tparam Pack RegisterPack describing the payload
+ */
+template <auto Type, typename Pack> struct TlvCase {
+  static constexpr auto type = Type;
+  using pack = Pack;
+};
+
+/**
+ * @brief Zero-copy view over a sequence of type-length-value records
+ *
+ * Each record starts with a HeaderPack holding the type in TypeReg and the
+ * payload length in bytes, excluding the header, in LengthReg. Iteration
+ * stops after the announced number of records or at the first record that
+ * does not fit the buffer.
+ *
+ * @tparam HeaderPack RegisterPack of the TLV header
+ * @tparam TypeReg PackedRegister of HeaderPack holding the type
+ * @tparam LengthReg PackedRegister of HeaderPack holding the payload length
+ */
+template <typename HeaderPack, typename TypeReg, typename LengthReg>
+class TlvRange {
+public:
+  using type_value = typename TypeReg::reg_type;
+
+  static constexpr std::size_t header_size =
+      sizeof(typename HeaderPack::target_type);
+
+  /**
+   * @brief one TLV record
+   *
+   */
+  struct value_type {
+    type_value type;
+    std::span<const std::byte> payload;
+
+    /**
+     * @brief read a PackedRegister of the payload pack
+     *
+     */
+    template <typename Reg> typename Reg::reg_type read() const {
+      return Reg::decode(payload);
+    }
+
+    /**
+     * @brief true if the payload is large enough for Pack
+     *
+     */
+    template <typename Pack> bool fits() const {
+      return payload.size() >= sizeof(typename Pack::target_type);
+    }
+  };
+
+  class iterator {
+  public:
+    using value_type = TlvRange::value_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::input_iterator_tag;
+
+    iterator() = default;
+
+    iterator(std::span<const std::byte> rest, std::size_t remaining)
+        : _rest(rest), _remaining(remaining) {
+      parse();
+    }
+
+    const value_type &operator*() const { return _current; }
+    const value_type *operator->() const { return &_current; }
+
+    iterator &operator++() {
+      _rest = _rest.subspan(header_size + _current.payload.size());
+      _remaining--;
+      parse();
+      return *this;
+    }
+
+    iterator operator++(int) {
+      auto previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    bool operator==(std::default_sentinel_t) const { return _remaining == 0; }
+
+  private:
+    void parse() {
+      if (_remaining == 0) {
+        return;
+      }
+
+      if (_rest.size() < header_size) {
+        _remaining = 0;
+        return;
+      }
+
+      const std::size_t length = LengthReg::decode(_rest);
+
+      if (length > _rest.size() - header_size) {
+        _remaining = 0;
+        return;
+      }
+
+      _current = {TypeReg::decode(_rest), _rest.subspan(header_size, length)};
+    }
+
+    std::span<const std::byte> _rest;
+    std::size_t _remaining = 0;
+    value_type _current{};
+  };
+
+  TlvRange() = default;
+
+  /**
+   * @brief TLVs in tlvs, at most count of them
+   *
+   * @param tlvs bytes following the frame header
+   * @param count number of TLVs announced by the frame header
+   */
+  TlvRange(std::span<const std::byte> tlvs, std::size_t count)
+      : _tlvs(tlvs), _count(count) {}
+
+  /**
+   * @brief TLVs of a frame, bounded by the frame's total length
+   *
+   * The TLVs start right after the frame header pack. An empty range is
+   * returned if the frame is shorter than its header or its total length.
+   *
+   * @tparam TotalLengthReg PackedRegister of the frame header holding the
+   * total frame length in bytes, header included
+   * @tparam CountReg PackedRegister of the frame header holding the number
+   * of TLVs
+   * @param frame
+   * @return TlvRange
+   */
+  template <typename TotalLengthReg, typename CountReg>
+  static TlvRange from_frame(std::span<const std::byte> frame) {
+    constexpr std::size_t frame_header_size =
+        sizeof(typename TotalLengthReg::reg_pack::target_type);
+
+    if (frame.size() < frame_header_size) {
+      return {};
+    }
+
+    const std::size_t total_length = TotalLengthReg::decode(frame);
+
+    if (total_length < frame_header_size || total_length > frame.size()) {
+      return {};
+    }
+
+    return {frame.subspan(frame_header_size,
+                          total_length - frame_header_size),
+            CountReg::decode(frame)};
+  }
+
+  iterator begin() const { return {_tlvs, _count}; }
+
+  std::default_sentinel_t end() const { return {}; }
+
+  /**
+   * @brief true if all announced TLVs fit the buffer
+   *
+   */
+  bool valid() const {
+    std::size_t parsed = 0;
+    for (auto it = begin(); it != end(); ++it) {
+      parsed++;
+    }
+    return parsed == _count;
+  }
+
+  /**
+   * @brief call f(Case{}, payload) with the first case matching the type
+   * of tlv, cases whose pack does not fit the payload are skipped
+   *
+   * @tparam Cases TlvCase instances
+   * @return true if a case was called
+   */
+  template <typename... Cases, typename F>
+  static bool dispatch(const value_type &tlv, F &&f) {
+    return ((tlv.type == static_cast<type_value>(Cases::type) &&
+             tlv.template fits<typename Cases::pack>() &&
+             (f(Cases{}, tlv.payload), true)) ||
+            ...);
+  }
+
+private:
+  std::span<const std::byte> _tlvs;
+  std::size_t _count = 0;
+};
+
+} // namespace regs
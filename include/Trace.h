@@ -0,0 +1,249 @@
+#pragma once
+
+#include "TypeName.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace regs {
+
+enum class trace_op : std::uint8_t { read, write };
+
+/**
+ * @brief Tracing policy doing nothing, the default
+ *
+ * RegisterBase checks enabled with if constexpr, so no code is generated for
+ * registers using this policy.
+ *
+ */
+struct no_trace {
+  static constexpr bool enabled = false;
+};
+
+/**
+ * @brief accesses of one field, whole register accesses are recorded with
+ * field_name equal to reg_name
+ *
+ */
+struct trace_stats {
+  std::string_view reg_name;
+  std::string_view field_name;
+
+  std::atomic<std::uint64_t> reads{0};
+  std::atomic<std::uint64_t> writes{0};
+  std::atomic<std::uint64_t> last_value{0};
+  // steady_clock nanoseconds of the last access
+  std::atomic<std::uint64_t> last_timestamp{0};
+
+  trace_stats *next = nullptr;
+
+  /**
+   * @brief links the stats into list, lock free
+   *
+   */
+  trace_stats(std::string_view reg, std::string_view field,
+              std::atomic<trace_stats *> &list)
+      : reg_name(reg), field_name(field), next(list.load()) {
+    while (!list.compare_exchange_weak(next, this)) {
+    }
+  }
+};
+
+/**
+ * @brief one access, values wider than 64 bit or not trivially copyable are
+ * recorded as 0
+ *
+ */
+struct trace_event {
+  std::uint64_t timestamp;
+  const trace_stats *field;
+  const void *reg;
+  std::uint64_t value;
+  std::uint32_t index;
+  trace_op op;
+};
+
+namespace details {
+
+template <typename T> std::uint64_t trace_value(const T &value) {
+  if constexpr (std::is_enum_v<T>) {
+    return static_cast<std::uint64_t>(value);
+  } else if constexpr (std::is_trivially_copyable_v<T> &&
+                       sizeof(T) <= sizeof(std::uint64_t)) {
+    std::uint64_t result = 0;
+    std::memcpy(&result, &value, sizeof(T));
+    return result;
+  } else {
+    return 0;
+  }
+}
+
+inline std::uint64_t trace_now() {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+} // namespace details
+
+/**
+ * @brief Tracing policy counting the accesses of every field and keeping the
+ * last Capacity accesses of each thread
+ *
+ * Counters are shared between threads and updated with relaxed atomics. The
+ * events go to a ring buffer per thread, so recording never takes a lock.
+ *
+ * @tparam Capacity events kept per thread, a power of two
+ */
+template <std::size_t Capacity = 1024> class ring_trace {
+ public:
+
+ static constexpr bool enabled = true;
+
+ static constexpr std::size_t capacity = Capacity;
+
+ static_assert(std::has_single_bit(Capacity),
+               "capacity must be a power of two");
+
+ private:
+
+ struct ring {
+   std::array<trace_event, Capacity> events;
+   // number of events recorded, the ring holds the last Capacity of them
+   std::uint64_t count = 0;
+ };
+
+ static inline std::atomic<trace_stats *> _stats{nullptr};
+
+ static inline thread_local ring _ring{};
+
+ template <typename Reg, typename TField> static trace_stats &stats_of() {
+   static trace_stats stats{details::type_name<Reg>(),
+                            details::type_name<TField>(), _stats};
+   return stats;
+ }
+
+  public:
+
+  /**
+   * @brief record an access of field TField of register Reg
+   *
+   * @param reg address of the register object
+   * @param index index into a FieldArray, 0 for plain fields
+   */
+  template <typename Reg, typename TField, typename Value>
+  static void record(trace_op op, const void *reg, std::size_t index,
+                     const Value &value) {
+    auto &stats = stats_of<Reg, TField>();
+    const auto now = details::trace_now();
+    const auto bits = details::trace_value(value);
+
+    (op == trace_op::read ? stats.reads : stats.writes)
+        .fetch_add(1, std::memory_order_relaxed);
+    stats.last_value.store(bits, std::memory_order_relaxed);
+    stats.last_timestamp.store(now, std::memory_order_relaxed);
+
+    _ring.events[_ring.count & (Capacity - 1)] = {
+        now, &stats, reg, bits, static_cast<std::uint32_t>(index), op};
+    _ring.count++;
+  }
+
+  /**
+   * @brief call f(const trace_stats &) for every field accessed so far
+   *
+   */
+  template <typename F> static void for_each_stats(F &&f) {
+    for (auto *stats = _stats.load(); stats != nullptr; stats = stats->next) {
+      f(std::as_const(*stats));
+    }
+  }
+
+  /**
+   * @brief last accesses of the calling thread, oldest first
+   *
+   */
+  static std::vector<trace_event> events() {
+    const auto count = std::min<std::uint64_t>(_ring.count, Capacity);
+
+    std::vector<trace_event> result;
+    result.reserve(count);
+    for (auto i = _ring.count - count; i < _ring.count; i++) {
+      result.push_back(_ring.events[i & (Capacity - 1)]);
+    }
+    return result;
+  }
+
+  /**
+   * @brief number of accesses of the calling thread, including the ones
+   * overwritten in the ring
+   *
+   */
+  static std::uint64_t recorded() { return _ring.count; }
+
+  /**
+   * @brief write counters and the events of the calling thread as text, out
+   * being any stream supporting operator<<
+   *
+   */
+  template <typename Out> static void dump(Out &out) {
+    for_each_stats([&](const trace_stats &stats) {
+      out << stats.reg_name << " " << stats.field_name
+          << " reads=" << stats.reads.load()
+          << " writes=" << stats.writes.load()
+          << " last=" << stats.last_value.load()
+          << " at=" << stats.last_timestamp.load() << "\n";
+    });
+
+    for (const auto &event : events()) {
+      out << event.timestamp
+          << (event.op == trace_op::read ? " read " : " write ")
+          << event.field->field_name << "[" << event.index << "] @"
+          << event.reg << " = " << event.value << "\n";
+    }
+  }
+
+  /**
+   * @brief zero all counters and drop the events of the calling thread
+   *
+   */
+  static void reset() {
+    for (auto *stats = _stats.load(); stats != nullptr; stats = stats->next) {
+      stats->reads = 0;
+      stats->writes = 0;
+      stats->last_value = 0;
+      stats->last_timestamp = 0;
+    }
+    _ring.count = 0;
+  }
+};
+
+/**
+ * @brief tracing policy of register Reg
+ *
+ * no_trace unless REGS_TRACE is defined. Specialize it to trace single
+ * registers without touching their definition:
+ *
+ *   template <> struct regs::trace_policy<Ctrl> {
+ *     using type = regs::ring_trace<>;
+ *   };
+ *
+ */
+template <typename Reg> struct trace_policy {
+#if defined(REGS_TRACE)
+  using type = ring_trace<>;
+#else
+  using type = no_trace;
+#endif
+};
+
+} // namespace regs
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string_view>
+
+namespace regs {
+
+namespace details {
+
+/**
+ * @brief name of T as spelled by the compiler
+ *
+ */
+template <typename T> constexpr std::string_view type_name() {
+#if defined(__clang__) || defined(__GNUC__)
+  constexpr std::string_view function = __PRETTY_FUNCTION__;
+  constexpr auto start = function.find("T = ") + 4;
+  constexpr auto end = function.find_first_of(";]", start);
+  return function.substr(start, end - start);
+#elif defined(_MSC_VER)
+  constexpr std::string_view function = __FUNCSIG__;
+  constexpr auto start = function.find("type_name<") + 10;
+  constexpr auto end = function.rfind(">(void)");
+  auto name = function.substr(start, end - start);
+  for (std::string_view prefix : {"struct ", "class ", "enum "}) {
+    if (name.starts_with(prefix)) {
+      name.remove_prefix(prefix.size());
+    }
+  }
+  return name;
+#else
+  return {};
+#endif
+}
+
+} // namespace details
+
+} // namespace regs
@@ -0,0 +1,79 @@
+# Checks the disassembly of the codegen objects.
+#
+# Every function named codegen_max<N>_<name> must have at most N
+# instructions and no backward jump.
+#
+# cmake -DOBJDUMP=<objdump> -DOBJECTS=<objects> -P CheckCodegen.cmake
+
+if(NOT OBJDUMP OR NOT OBJECTS)
+    message(FATAL_ERROR "OBJDUMP and OBJECTS are required")
+endif()
+
+set(failures 0)
+set(checked 0)
+
+foreach(object IN LISTS OBJECTS)
+    execute_process(
+        COMMAND ${OBJDUMP} -d --no-show-raw-insn ${object}
+        OUTPUT_VARIABLE disassembly
+        RESULT_VARIABLE result)
+
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${OBJDUMP} failed on ${object}")
+    endif()
+
+    string(REPLACE ";" "," disassembly "${disassembly}")
+    string(REPLACE "\n" ";" lines "${disassembly}")
+
+    set(function "")
+
+    # the empty entry closes the last function
+    foreach(line IN LISTS lines ITEMS "")
+        if(line MATCHES "^[0-9a-f]+ <(codegen_max([0-9]+)_[A-Za-z0-9_]+)>:")
+            set(function ${CMAKE_MATCH_1})
+            set(limit ${CMAKE_MATCH_2})
+            set(count 0)
+            set(loops 0)
+            set(listing "")
+        elseif(function AND line MATCHES "^ *([0-9a-f]+):[ \t]+([a-z][a-z0-9.]*)(.*)$")
+            set(address ${CMAKE_MATCH_1})
+            set(mnemonic ${CMAKE_MATCH_2})
+            set(operands "${CMAKE_MATCH_3}")
+
+            # padding and control flow protection are not part of the code
+            if(NOT mnemonic MATCHES "^(nop|nopw|nopl|xchg|endbr64|endbr32|int3|cs|data16)$")
+                math(EXPR count "${count} + 1")
+                string(APPEND listing "\n    ${mnemonic}${operands}")
+
+                if(mnemonic MATCHES "^j" AND operands MATCHES "^[ \t]+([0-9a-f]+) <")
+                    math(EXPR from "0x${address}")
+                    math(EXPR to "0x${CMAKE_MATCH_1}")
+                    if(to LESS_EQUAL from)
+                        math(EXPR loops "${loops} + 1")
+                    endif()
+                endif()
+            endif()
+        elseif(function AND line STREQUAL "")
+            math(EXPR checked "${checked} + 1")
+
+            if(count GREATER limit OR loops GREATER 0)
+                math(EXPR failures "${failures} + 1")
+                message(SEND_ERROR
+                    "${function}: ${count} instructions (max ${limit}), "
+                    "${loops} backward jumps${listing}")
+            else()
+                message(STATUS "${function}: ${count} instructions (max ${limit})")
+            endif()
+
+            set(function "")
+        endif()
+    endforeach()
+endforeach()
+
+if(checked EQUAL 0)
+    message(FATAL_ERROR "no codegen_max functions found")
+endif()
+
+if(failures GREATER 0)
+    message(FATAL_ERROR "${failures} of ${checked} accessors exceed their limits")
+endif()
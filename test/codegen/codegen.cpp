@@ -0,0 +1,169 @@
+/**
+ * @file codegen.cpp
+ * @brief representative accessors checked by CheckCodegen.cmake
+ *
+ * Every function named codegen_max<N>_<name> must compile to at most N
+ * instructions, ret included, and must not contain a backward jump.
+ *
+ */
+
+#include <AtomicRegister.h>
+#include <MmioRegister.h>
+#include <Register.h>
+#include <RegisterArray.h>
+#include <RegisterMap.h>
+#include <RegisterPack.h>
+
+using namespace regs;
+
+struct Ctrl;
+
+struct Ctrl : Register<Ctrl, uint32_t> {
+  using Enable = Field<Ctrl, 0, 1>;
+  using Mode = Field<Ctrl, 4, 3>;
+  using Level = Field<Ctrl, 20, 6, 0, read_write, uint8_t>;
+  using Byte = Field<Ctrl, 8, 8, 0, read_write, uint8_t>;
+
+  enum class Speed : uint8_t { Slow = 0, Medium = 1, Fast = 2, Turbo = 3 };
+  using Clock = Field<Ctrl, 28, 2, 0, read_write, Speed>;
+
+  using Lane = FieldArray<Ctrl, 0, 4, 8, 4>;
+};
+
+struct Timer;
+
+struct Timer : Register<Timer, uint32_t> {
+  using Enable = Field<Timer, 0, 1, 0, read_write, uint32_t, 1>;
+  using Prescaler = Field<Timer, 4, 4, 0, read_write, uint8_t, 7>;
+
+  using field_map = FieldMap<Timer, Enable, Prescaler>;
+};
+
+struct Wide;
+
+struct Wide : Register<Wide, uint64_t> {
+  using Span = Field<Wide, 29, 12, 0, read_write, uint16_t>;
+};
+
+struct Pack : RegisterPack<16> {
+  using RegisterPack::RegisterPack;
+};
+
+struct Status;
+
+struct Status : PackedRegister<Pack, Status, 4, uint32_t> {
+  using PackedRegister::PackedRegister;
+
+  using Code = Field<Status, 20, 6, 0, read_write, uint8_t>;
+};
+
+struct NetStatus;
+
+struct NetStatus
+    : PackedRegister<Pack, NetStatus, 8, uint32_t, std::endian::big> {
+  using PackedRegister::PackedRegister;
+
+  using Length = Field<NetStatus, 4, 12, 0, read_write, uint16_t>;
+};
+
+struct GPIO;
+
+struct GPIO : MmioRegister<GPIO, uint32_t, 0x40014004> {
+  using FuncSel = Field<GPIO, 0, 5>;
+  using OutOver = Field<GPIO, 8, 2>;
+};
+
+struct Shared;
+
+struct Shared : AtomicRegister<Shared, uint32_t> {
+  using Ready = Field<Shared, 0, 1>;
+};
+
+extern "C" {
+
+uint8_t codegen_max4_masked_read(Ctrl &reg) {
+  return reg.read<Ctrl::Level>();
+}
+
+uint8_t codegen_max2_trivial_read(Ctrl &reg) { return reg.read<Ctrl::Byte>(); }
+
+Ctrl::Speed codegen_max4_enum_read(Ctrl &reg) {
+  return reg.read<Ctrl::Clock>();
+}
+
+uint16_t codegen_max4_wide_masked_read(Wide &reg) {
+  return reg.read<Wide::Span>();
+}
+
+void codegen_max7_masked_write(Ctrl &reg, uint8_t value) {
+  reg.write<Ctrl::Level>(value);
+}
+
+void codegen_max2_trivial_write(Ctrl &reg, uint8_t value) {
+  reg.write<Ctrl::Byte>(value);
+}
+
+void codegen_max5_constant_write(Ctrl &reg) {
+  reg.write<Ctrl::Mode, 5>();
+}
+
+void codegen_max5_multi_constant_write(Ctrl &reg) {
+  reg.write<Ctrl::Enable::Value<1>, Ctrl::Mode::Value<2>,
+            Ctrl::Level::Value<7>>();
+}
+
+// load, shift and mask plus the range check kept in release builds
+uint32_t codegen_max8_runtime_index_read(Ctrl &reg, std::size_t index) {
+  return reg.read<Ctrl::Lane>(index);
+}
+
+uint8_t codegen_max5_packed_read(Status &reg) {
+  return reg.read<Status::Code>();
+}
+
+uint16_t codegen_max5_big_endian_read(NetStatus &reg) {
+  return reg.read<NetStatus::Length>();
+}
+
+uint8_t codegen_max4_view_packed_read(PackView<Pack> view) {
+  return view.reg<Status>().read<Status::Code>();
+}
+
+uint8_t codegen_max4_const_view_read(PackView<const Pack> view) {
+  return view.read<Status::Code>();
+}
+
+uint16_t codegen_max4_view_big_endian_read(PackView<Pack> view) {
+  return view.reg<NetStatus>().read<NetStatus::Length>();
+}
+
+void codegen_max5_mmio_constant_write() {
+  GPIO{}.write<GPIO::FuncSel::Value<5>, GPIO::OutOver::Value<3>>();
+}
+
+void codegen_max2_bit_set(Ctrl &reg) { reg.set<Ctrl::Enable>(); }
+
+void codegen_max2_multi_bit_clear(Ctrl &reg) {
+  reg.clear<Ctrl::Enable, Ctrl::Mode, Ctrl::Clock>();
+}
+
+bool codegen_max3_bit_test(Ctrl &reg) { return reg.test<Ctrl::Enable>(); }
+
+void codegen_max4_mmio_bit_toggle() {
+  GPIO{}.toggle<GPIO::FuncSel, GPIO::OutOver>();
+}
+
+void codegen_max2_reset(Timer &reg) { reg.reset(); }
+
+void codegen_max2_init(Timer &reg) {
+  reg.init<Timer::Enable::Value<0>, Timer::Prescaler::Value<3>>();
+}
+
+void codegen_max4_reset_all(PackView<Pack> view) {
+  RegisterMap<Pack, Status, NetStatus>::reset_all(view);
+}
+
+void codegen_max2_atomic_set(Shared &reg) {
+  reg.set<Shared::Ready>(std::memory_order_relaxed);
+}
+}
@@ -0,0 +1,103 @@
+#include <AtomicRegister.h>
+#include <RegisterArray.h>
+
+#include <catch2/catch_all.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace regs;
+
+struct SharedStatus;
+
+struct SharedStatus : AtomicRegister<SharedStatus, uint32_t> {
+  using Ready = Field<SharedStatus, 0, 1>;
+  using Error = Field<SharedStatus, 1, 1>;
+  using Owner = Field<SharedStatus, 4, 4, 0, read_write, uint8_t>;
+
+  // one 4 bit counter per worker thread
+  using Counter = FieldArray<SharedStatus, 8, 4, 6, 4, 0, read_write, uint8_t>;
+};
+
+TEST_CASE("AtomicFields", "[atomic]") {
+  SharedStatus status;
+
+  REQUIRE(status.read() == 0);
+
+  REQUIRE(status.set<SharedStatus::Ready>() == 0);
+  REQUIRE(status.set<SharedStatus::Ready>() == 1);
+  REQUIRE(status.read<SharedStatus::Ready>(std::memory_order_acquire) == 1);
+
+  status.write<SharedStatus::Owner>(0xA);
+  REQUIRE(status.read<SharedStatus::Owner>() == 0xA);
+
+  REQUIRE(status.toggle<SharedStatus::Owner>() == 0xA);
+  REQUIRE(status.read<SharedStatus::Owner>() == 0x5);
+
+  REQUIRE(status.clear<SharedStatus::Ready>() == 1);
+  REQUIRE(status.read() == 0x50);
+
+  status.modify<SharedStatus::Error, SharedStatus::Owner>(1, 0x3);
+  REQUIRE(status.read() == 0x32);
+
+  status.write<SharedStatus::Counter>(2, 7);
+  REQUIRE(status.read<SharedStatus::Counter>(2) == 7);
+}
+
+TEST_CASE("AtomicMultiFieldBits", "[atomic]") {
+  SharedStatus status;
+
+  status.set<SharedStatus::Ready, SharedStatus::Error>();
+  REQUIRE(status.read() == 0x3);
+  REQUIRE(status.test<SharedStatus::Ready, SharedStatus::Error>());
+
+  status.toggle<SharedStatus::Error, SharedStatus::Owner>();
+  REQUIRE(status.read() == 0xF1);
+
+  status.clear<SharedStatus::Ready, SharedStatus::Owner>();
+  REQUIRE(status.read() == 0);
+  REQUIRE_FALSE(status.test<SharedStatus::Ready, SharedStatus::Error>());
+
+  // a single field still takes the atomic overload returning the previous
+  // value
+  REQUIRE(status.set<SharedStatus::Error>() == 0);
+  REQUIRE(status.test<SharedStatus::Error>());
+}
+
+TEST_CASE("AtomicStress", "[atomic]") {
+  SharedStatus status;
+
+  constexpr std::size_t threads = SharedStatus::Counter::count;
+  constexpr std::size_t iterations = 20000;
+
+  std::vector<std::thread> workers;
+
+  for (std::size_t t = 0; t < threads; t++) {
+    workers.emplace_back([&status, t] {
+      for (std::size_t i = 0; i < iterations; i++) {
+        // read-modify-write of the own counter, neighbours write
+        // concurrently to the same word
+        auto value = status.read<SharedStatus::Counter>(t);
+        status.write<SharedStatus::Counter>(
+            t, static_cast<uint8_t>((value + 1) & 0xF));
+
+        // the shared flags are flipped by everyone
+        status.toggle<SharedStatus::Ready>();
+        status.toggle<SharedStatus::Error>();
+      }
+    });
+  }
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  for (std::size_t t = 0; t < threads; t++) {
+    REQUIRE(status.read<SharedStatus::Counter>(t) == iterations % 16);
+  }
+
+  // an even number of toggles in total
+  REQUIRE(status.read<SharedStatus::Ready>() == 0);
+  REQUIRE(status.read<SharedStatus::Error>() == 0);
+  REQUIRE(status.read<SharedStatus::Owner>() == 0);
+}
@@ -1,7 +1,10 @@
 
 #include "catch2/matchers/catch_matchers_floating_point.hpp"
 #include <RegisterPack.h>
+#include <FrameBuilder.h>
 #include <RegisterArray.h>
+#include <SegmentedPack.h>
+#include <Tlv.h>
 
 #include <catch2/catch_all.hpp>
 #include <sys/types.h>
@@ -22,6 +25,7 @@ struct FrameHeader : public RegisterPack<40> {
   struct total_length
     : public PackedRegister<FrameHeader, total_length, 12, uint32_t> {};
   struct platform : public PackedRegister<FrameHeader, platform, 16, uint32_t> {};
+  struct frame_no : public PackedRegister<FrameHeader, frame_no, 20, uint32_t> {};
   struct time_cpu_cycle
     : public PackedRegister<FrameHeader, time_cpu_cycle, 24, uint32_t> {};
   struct detect_obj_no
@@ -172,4 +176,322 @@ TEST_CASE("RegSet", "[regs]") {
 
 
 
+}
+
+using FrameTlvs = TlvRange<TlvHeader, TlvHeader::TlvType, TlvHeader::Length>;
+
+static constexpr uint32_t kDetectedPointsTlv = 1;
+
+TEST_CASE("TlvRange", "[regs]") {
+
+  std::span<const std::byte> frame{raw_data};
+
+  auto tlvs = FrameTlvs::from_frame<FrameHeader::total_length,
+                                    FrameHeader::tlvs_no>(frame);
+
+  REQUIRE(tlvs.valid());
+
+  std::size_t count = 0;
+  std::vector<DetectedPointValue> points;
+
+  for (const auto &tlv : tlvs) {
+    count++;
+
+    REQUIRE(tlv.type == kDetectedPointsTlv);
+    REQUIRE(tlv.payload.size() == 48);
+    REQUIRE(tlv.payload.data() == &raw_data[kDetectedPointPayloadOffset]);
+
+    bool handled =
+        FrameTlvs::dispatch<TlvCase<kDetectedPointsTlv, DetectedPointsArray>>(
+            tlv, [&](auto, std::span<const std::byte> payload) {
+              for (std::size_t i = 0; i < DetectedPointArray::count; i++) {
+                points.push_back(DetectedPointArray::decode(payload, i));
+              }
+            });
+
+    REQUIRE(handled);
+  }
+
+  REQUIRE(count == 1);
+  REQUIRE(points.size() == 3);
+
+  REQUIRE_THAT(points[0].x, WithinAbs(0.07912108, 0.000001));
+  REQUIRE_THAT(points[1].z, WithinAbs(-0.474726528, 0.000001));
+  REQUIRE_THAT(points[2].y, WithinAbs(0.5167, 0.001));
+}
+
+TEST_CASE("TlvRangeTruncated", "[regs]") {
+
+  std::span<const std::byte> frame{raw_data};
+
+  // frame shorter than its total length
+  REQUIRE(FrameTlvs::from_frame<FrameHeader::total_length,
+                                FrameHeader::tlvs_no>(frame.first(80))
+              .begin() == std::default_sentinel);
+
+  // payload longer than the remaining bytes
+  FrameTlvs truncated{frame.subspan(40, 40), 1};
+
+  REQUIRE(truncated.begin() == std::default_sentinel);
+  REQUIRE_FALSE(truncated.valid());
+
+  // more TLVs announced than present
+  FrameTlvs missing{frame.subspan(40), 2};
+
+  std::size_t count = 0;
+  for ([[maybe_unused]] const auto &tlv : missing) {
+    count++;
+  }
+
+  REQUIRE(count == 1);
+  REQUIRE_FALSE(missing.valid());
+
+  // payload too short for the pack of the matching case
+  FrameTlvs::value_type tlv{kDetectedPointsTlv, frame.subspan(48, 16)};
+
+  REQUIRE_FALSE(
+      FrameTlvs::dispatch<TlvCase<kDetectedPointsTlv, DetectedPointsArray>>(
+          tlv, [](auto, auto) {}));
+}
+
+using Point = DetectedPointArray::reg<0>;
+
+TEST_CASE("DecodeColumns", "[regs]") {
+
+  std::span<const std::byte> payload{raw_data + kDetectedPointPayloadOffset,
+                                     48};
+
+  std::array<float, 3> x, y, z, v;
+
+  DetectedPointArray::decode_columns<Point::x, Point::y, Point::z, Point::v>(
+      payload, 3, x, y, z, v);
+
+  for (std::size_t i = 0; i < 3; i++) {
+    auto point = DetectedPointArray::decode(payload, i);
+
+    REQUIRE(x[i] == point.x);
+    REQUIRE(y[i] == point.y);
+    REQUIRE(z[i] == point.z);
+    REQUIRE(v[i] == point.v);
+  }
+
+  // enough records for the vectorized blocks plus a scalar tail
+  constexpr std::size_t count = 1003;
+
+  std::vector<std::byte> records(count * kDetectedPointStrideBytes);
+  for (std::size_t i = 0; i < count; i++) {
+    DetectedPointValue point{float(i), float(i) * 0.5f, -float(i), 1.0f};
+    std::memcpy(records.data() + i * kDetectedPointStrideBytes, &point,
+                sizeof(point));
+  }
+
+  std::vector<float> xs(count), vs(count), zs(count);
+
+  DetectedPointArray::decode_columns<Point::z, Point::x, Point::v>(
+      records, count, zs, xs, vs);
+
+  for (std::size_t i = 0; i < count; i++) {
+    REQUIRE(xs[i] == float(i));
+    REQUIRE(zs[i] == -float(i));
+    REQUIRE(vs[i] == 1.0f);
+  }
+}
+
+using TlvBuilder = FrameBuilder<TlvHeader, Fixed<TlvHeader::TlvType, 1u>,
+                                PayloadLength<TlvHeader::Length>>;
+
+using FrameHeaderBuilder =
+    FrameBuilder<FrameHeader, Fixed<FrameHeader::Magic0, 0x03040102u>,
+                 Fixed<FrameHeader::Magic1, 0x07080506u>,
+                 Fixed<FrameHeader::Version, 0x03050004u>,
+                 TotalLength<FrameHeader::total_length>, FrameHeader::platform,
+                 FrameHeader::frame_no, FrameHeader::time_cpu_cycle,
+                 FrameHeader::detect_obj_no, FrameHeader::tlvs_no>;
+
+TEST_CASE("FrameBuilder", "[regs]") {
+  STATIC_REQUIRE(FrameHeaderBuilder::runtime_count == 5);
+  STATIC_REQUIRE(FrameHeaderBuilder::image[0] == 0x02_b);
+  STATIC_REQUIRE(FrameHeaderBuilder::image[11] == 0x03_b);
+  STATIC_REQUIRE(TlvBuilder::runtime_count == 0);
+
+  std::span<const std::byte> points{raw_data + kDetectedPointPayloadOffset,
+                                    48};
+
+  std::array<std::byte, 96> frame;
+  frame.fill(0xEE_b);
+
+  // the TLV is encoded in place behind the frame header
+  auto tlv_size = TlvBuilder::encode(
+      std::span{frame}.subspan(FrameHeaderBuilder::header_size), points);
+  REQUIRE(tlv_size == 56);
+
+  auto header_size = FrameHeaderBuilder::encode_header(
+      frame, tlv_size, 0x3f96f3b6u, 29u, 2890657403u, 3u, 1u);
+  REQUIRE(header_size == 40);
+
+  REQUIRE(std::equal(frame.begin(), frame.end(), std::begin(raw_data)));
+}
+
+struct CommandHeader : public RegisterPack<12> {
+  using RegisterPack::RegisterPack;
+
+  struct Opcode : public PackedRegister<CommandHeader, Opcode, 0, uint16_t> {};
+
+  struct Flags : public PackedRegister<CommandHeader, Flags, 2, uint16_t,
+                                       std::endian::big> {
+    using Ack = Field<Flags, 0, 1>;
+    using Channel = Field<Flags, 4, 4, 0, read_write, uint8_t>;
+    using Priority = Field<Flags, 12, 3, 0, read_write, uint8_t>;
+  };
+
+  struct Length : public PackedRegister<CommandHeader, Length, 4, uint32_t,
+                                        std::endian::big> {};
+  struct Sequence
+      : public PackedRegister<CommandHeader, Sequence, 8, uint32_t> {};
+};
+
+using CommandBuilder =
+    FrameBuilder<CommandHeader, Fixed<CommandHeader::Opcode, uint16_t{0x0102}>,
+                 CommandHeader::Flags::Ack::Value<1>,
+                 CommandHeader::Flags::Priority::Value<5>,
+                 CommandHeader::Flags::Channel, CommandHeader::Sequence,
+                 TotalLength<CommandHeader::Length>>;
+
+TEST_CASE("FrameBuilderFields", "[regs]") {
+  // constant fields of a big endian register are folded at compile time
+  STATIC_REQUIRE(CommandBuilder::image[2] == 0x50_b);
+  STATIC_REQUIRE(CommandBuilder::image[3] == 0x01_b);
+
+  const std::array<std::byte, 3> payload = {0xAA_b, 0xBB_b, 0xCC_b};
+  std::array<std::byte, 16> out{};
+
+  auto size = CommandBuilder::encode(out, payload, 0xA, 0x11223344u);
+  REQUIRE(size == 15);
+
+  CommandHeader header;
+  std::copy(out.begin(), out.begin() + 12, header._target.begin());
+
+  REQUIRE(CommandHeader::Opcode{header}.read() == 0x0102);
+  CommandHeader::Flags flags{header};
+  REQUIRE(flags.read<CommandHeader::Flags::Ack>() == 1);
+  REQUIRE(flags.read<CommandHeader::Flags::Channel>() == 0xA);
+  REQUIRE(flags.read<CommandHeader::Flags::Priority>() == 5);
+  REQUIRE(CommandHeader::Length{header}.read() == 15);
+  REQUIRE(out[7] == std::byte{15});
+  REQUIRE(CommandHeader::Sequence{header}.read() == 0x11223344u);
+  REQUIRE(out[14] == 0xCC_b);
+}
+
+TEST_CASE("SegmentedPack", "[regs]") {
+  const std::span<const std::byte> data{raw_data};
+
+  // boundaries inside magic, total_length, an empty segment and the TLV length
+  const std::array<std::span<const std::byte>, 5> segments = {
+      data.subspan(0, 6), data.subspan(6, 8), data.subspan(14, 0),
+      data.subspan(14, 32), data.subspan(46)};
+
+  SegmentedPack<FrameHeader> header{segments};
+  REQUIRE(header.total_size() == 96);
+
+  REQUIRE(header.contiguous(FrameHeader::Version::offset, 4) != nullptr);
+  REQUIRE(header.contiguous(FrameHeader::Magic1::offset, 4) == nullptr);
+
+  REQUIRE(header.decode<FrameHeader::Magic0>() == 0x03040102u);
+  REQUIRE(header.decode<FrameHeader::Magic1>() == 0x07080506u);
+  REQUIRE(header.decode<FrameHeader::total_length>() == 96);
+  REQUIRE(header.decode<FrameHeader::platform>() ==
+          FrameHeader::platform::decode(data));
+  REQUIRE(header.decode<FrameHeader::tlvs_no>() == 1);
+
+  auto tlv = header.overlay<TlvHeader>(FrameHeaderBuilder::header_size);
+  REQUIRE(tlv.decode<TlvHeader::TlvType>() == 1);
+  REQUIRE(tlv.decode<TlvHeader::Length>() == 48);
+
+  // the second point straddles the last boundary
+  using Second = DetectedPointArray::reg<1>;
+  auto points = tlv.overlay<DetectedPointsArray>(8);
+  const auto second = points.decode<Second>();
+  REQUIRE_THAT(second.x, WithinAbs(0.184615865, 0.0001));
+  REQUIRE_THAT(second.z, WithinAbs(-0.474726528, 0.0001));
+
+  std::array<std::byte, 8> stitched;
+  header.copy_to(stitched, 4);
+  REQUIRE(std::equal(stitched.begin(), stitched.end(), raw_data + 4));
+}
+
+TEST_CASE("SegmentedPackFields", "[regs]") {
+  const std::array<std::byte, 3> payload = {0xAA_b, 0xBB_b, 0xCC_b};
+  std::array<std::byte, 15> out{};
+  CommandBuilder::encode(out, payload, 0xA, 0x11223344u);
+
+  // the big endian Flags register straddles the boundary
+  const std::span<const std::byte> data{out};
+  const std::array<std::span<const std::byte>, 2> segments = {
+      data.first(3), data.subspan(3)};
+
+  SegmentedPack<CommandHeader> header{segments};
+  REQUIRE(header.read<CommandHeader::Flags::Ack>() == 1);
+  REQUIRE(header.read<CommandHeader::Flags::Channel>() == 0xA);
+  REQUIRE(header.read<CommandHeader::Flags::Priority>() == 5);
+  REQUIRE(header.decode<CommandHeader::Length>() == 15);
+  REQUIRE(header.decode<CommandHeader::Sequence>() == 0x11223344u);
+
+  using Nibbles = FieldArray<CommandHeader::Sequence, 0, 4, 8>;
+  REQUIRE(header.read<Nibbles>(0) == 4);
+  REQUIRE(header.read<Nibbles>(7) == 1);
+
+#if defined(REGS_HAS_IOVEC)
+  std::array<iovec, 3> vectors = {
+      iovec{out.data(), 5}, iovec{out.data() + 5, 0},
+      iovec{out.data() + 5, out.size() - 5}};
+
+  SegmentedPack<CommandHeader, iovec> gathered{vectors};
+  REQUIRE(gathered.read<CommandHeader::Flags::Channel>() == 0xA);
+  REQUIRE(gathered.decode<CommandHeader::Length>() == 15);
+#endif
+}
+
+TEST_CASE("PackView", "[regs]") {
+  std::array<std::byte, 96> frame;
+  std::copy(std::begin(raw_data), std::end(raw_data), frame.begin());
+
+  PackView<FrameHeader, std::dynamic_extent> header{std::span{frame}};
+  REQUIRE(header.reg<FrameHeader::Magic0>().read() == 0x03040102);
+  REQUIRE(FrameHeader::total_length{header}.read() == 96);
+  REQUIRE(header.decode<FrameHeader::detect_obj_no>() == 3);
+
+  auto tlv = header.overlay<TlvHeader>(40);
+  REQUIRE(tlv.decode<TlvHeader::TlvType>() == 1);
+  REQUIRE(TlvHeader::Length{tlv}.read() == 48);
+
+  auto points = header.overlay<DetectedPointsArray>(kDetectedPointPayloadOffset);
+  REQUIRE_THAT(DetectedPointArray::read(points, 1).y,
+               WithinAbs(0.672917, 0.0001));
+
+  // writes go straight to the buffer
+  DetectedPointArray::write(points, 2, DetectedPointValue{1, 2, 3, 4});
+  REQUIRE_THAT(DetectedPointArray::decode(
+                   std::span<const std::byte>{frame}.subspan(
+                       kDetectedPointPayloadOffset),
+                   2)
+                   .z,
+               WithinAbs(3, 0.0001));
+
+  tlv.reg<TlvHeader::Length>().write(16);
+  REQUIRE(frame[44] == 0x10_b);
+
+  // fixed extent over exactly the header, read-only
+  PackView<const FrameHeader> fixed{
+      std::span<const std::byte, 40>{frame.data(), 40}};
+  REQUIRE(fixed.decode<FrameHeader::tlvs_no>() == 1);
+
+  PackView<const TlvHeader> readonly = tlv;
+  REQUIRE(readonly.decode<TlvHeader::Length>() == 16);
+
+  // owning packs convert to views
+  CommandHeader command;
+  PackView view{command};
+  view.reg<CommandHeader::Flags>().write<CommandHeader::Flags::Channel>(3);
+  REQUIRE(view.read<CommandHeader::Flags::Channel>() == 3);
+  REQUIRE(command._target[3] == 0x30_b);
 }
@@ -68,3 +68,87 @@ TEST_CASE("ByteShift", "[byte_array]") {
     REQUIRE(shifted_right_by_three[2] == std::byte{0x90});
     REQUIRE(shifted_right_by_three[3] == std::byte{0x10});
 }
+
+TEST_CASE("ByteShiftLeft", "[byte_array]") {
+    byte_array toBeShifted = {std::byte(0x81), std::byte(0x82), std::byte(0x83),
+                              std::byte(0x84)};
+
+    auto shifted_left_by_one = array_shift_left(toBeShifted, 1);
+
+    REQUIRE(shifted_left_by_one[0] == std::byte{0x02});
+    REQUIRE(shifted_left_by_one[1] == std::byte{0x05});
+    REQUIRE(shifted_left_by_one[2] == std::byte{0x07});
+    REQUIRE(shifted_left_by_one[3] == std::byte{0x09});
+
+    auto shifted_left_by_twelve = array_shift_left(toBeShifted, 12);
+
+    REQUIRE(shifted_left_by_twelve[0] == std::byte{0x00});
+    REQUIRE(shifted_left_by_twelve[1] == std::byte{0x10});
+    REQUIRE(shifted_left_by_twelve[2] == std::byte{0x28});
+    REQUIRE(shifted_left_by_twelve[3] == std::byte{0x38});
+
+    auto shifted_out = array_shift_left(toBeShifted, 32);
+
+    REQUIRE(shifted_out[0] == std::byte{0x00});
+    REQUIRE(shifted_out[3] == std::byte{0x00});
+}
+
+TEST_CASE("ByteShiftTruncate", "[byte_array]") {
+    byte_array toBeShifted = {std::byte(0x81), std::byte(0x82), std::byte(0x83)};
+
+    auto shifted = array_shift_right<3, unsigned, 2>(toBeShifted, 4);
+
+    STATIC_REQUIRE(shifted.size() == 2);
+    REQUIRE(shifted[0] == std::byte{0x28});
+    REQUIRE(shifted[1] == std::byte{0x38});
+
+    auto widened = array_shift_right<3, unsigned, 4>(toBeShifted, 16);
+
+    REQUIRE(widened[0] == std::byte{0x83});
+    REQUIRE(widened[1] == std::byte{0x00});
+    REQUIRE(widened[3] == std::byte{0x00});
+}
+
+TEST_CASE("ByteShiftMultiWord", "[byte_array]") {
+    byte_array<12> toBeShifted;
+
+    for (std::size_t i = 0; i < toBeShifted.size(); i++) {
+        toBeShifted[i] = std::byte(0x10 + i);
+    }
+
+    auto shifted_right = array_shift_right(toBeShifted, 68);
+
+    REQUIRE(shifted_right[0] == std::byte{0x91});
+    REQUIRE(shifted_right[1] == std::byte{0xA1});
+    REQUIRE(shifted_right[2] == std::byte{0xB1});
+    REQUIRE(shifted_right[3] == std::byte{0x01});
+    REQUIRE(shifted_right[4] == std::byte{0x00});
+    REQUIRE(shifted_right[11] == std::byte{0x00});
+
+    auto shifted_left = array_shift_left(toBeShifted, 68);
+
+    REQUIRE(shifted_left[7] == std::byte{0x00});
+    REQUIRE(shifted_left[8] == std::byte{0x00});
+    REQUIRE(shifted_left[9] == std::byte{0x11});
+    REQUIRE(shifted_left[10] == std::byte{0x21});
+    REQUIRE(shifted_left[11] == std::byte{0x31});
+
+    auto round_trip = array_shift_right(array_shift_left(toBeShifted, 8), 8);
+
+    REQUIRE(round_trip[0] == std::byte{0x10});
+    REQUIRE(round_trip[10] == std::byte{0x1A});
+    REQUIRE(round_trip[11] == std::byte{0x00});
+}
+
+TEST_CASE("ByteShiftConstexpr", "[byte_array]") {
+    constexpr byte_array toBeShifted = {std::byte(0x81), std::byte(0x82),
+                                        std::byte(0x83), std::byte(0x84)};
+
+    constexpr auto shifted_right = array_shift_right(toBeShifted, 28);
+    constexpr auto shifted_left = array_shift_left(toBeShifted, 28);
+
+    STATIC_REQUIRE(shifted_right[0] == std::byte{0x08});
+    STATIC_REQUIRE(shifted_right[1] == std::byte{0x00});
+    STATIC_REQUIRE(shifted_left[3] == std::byte{0x10});
+    STATIC_REQUIRE(shifted_left[0] == std::byte{0x00});
+}
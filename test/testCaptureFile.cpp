@@ -0,0 +1,145 @@
+#include <CaptureFile.h>
+#include <RegisterPack.h>
+
+#include <catch2/catch_all.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace regs;
+
+struct CaptureHeader : public RegisterPack<16> {
+  using RegisterPack::RegisterPack;
+
+  struct Magic : public PackedRegister<CaptureHeader, Magic, 0, uint64_t> {};
+  struct total_length
+      : public PackedRegister<CaptureHeader, total_length, 8, uint32_t> {};
+  struct frame_no
+      : public PackedRegister<CaptureHeader, frame_no, 12, uint32_t> {};
+};
+
+using Capture = CaptureFile<CaptureHeader, CaptureHeader::total_length>;
+
+/**
+ * @brief temporary file removed at the end of the test
+ *
+ */
+struct TempFile {
+  std::string path;
+
+  explicit TempFile(const std::vector<std::byte> &content) {
+    char name[] = "/tmp/regs_captureXXXXXX";
+    const int fd = ::mkstemp(name);
+    REQUIRE(fd >= 0);
+    REQUIRE(::write(fd, content.data(), content.size()) ==
+            static_cast<ssize_t>(content.size()));
+    ::close(fd);
+    path = name;
+  }
+
+  ~TempFile() { std::remove(path.c_str()); }
+};
+
+static void append_frame(std::vector<std::byte> &capture, uint32_t length,
+                         uint32_t frame_no) {
+  const auto start = capture.size();
+  capture.resize(start + length);
+
+  const uint64_t magic = 0x0708050603040102;
+  std::memcpy(capture.data() + start, &magic, 8);
+  std::memcpy(capture.data() + start + 8, &length, 4);
+  std::memcpy(capture.data() + start + 12, &frame_no, 4);
+
+  for (std::size_t i = 16; i < length; i++) {
+    capture[start + i] = std::byte(frame_no + i);
+  }
+}
+
+TEST_CASE("CaptureFileIndex", "[capture]") {
+  std::vector<std::byte> content;
+  for (uint32_t frame_no = 0; frame_no < 100; frame_no++) {
+    append_frame(content, 16 + frame_no % 7 * 4, frame_no);
+  }
+
+  TempFile file{content};
+
+  auto capture = Capture::open(file.path.c_str());
+  REQUIRE(capture);
+  REQUIRE(capture->size() == 100);
+  REQUIRE(capture->trailing() == 0);
+  REQUIRE(capture->bytes().size() == content.size());
+
+  // random access
+  auto frame = (*capture)[43];
+  REQUIRE(frame.size() == 16 + 43 % 7 * 4);
+  REQUIRE(frame.decode<CaptureHeader::frame_no>() == 43);
+  REQUIRE(frame.payload().size() == frame.size() - 16);
+  REQUIRE(frame.payload()[0] == std::byte(43 + 16));
+
+  // overlays are zero copy
+  auto header = frame.header();
+  REQUIRE(header.data() == frame.bytes.data());
+  REQUIRE(CaptureHeader::Magic{header}.read() == 0x0708050603040102);
+  REQUIRE(header.reg<CaptureHeader::total_length>().read() == frame.size());
+
+  auto fixed = frame.overlay<const CaptureHeader>();
+  STATIC_REQUIRE(std::is_same_v<decltype(fixed)::byte_type, const std::byte>);
+  REQUIRE(fixed.data() == frame.bytes.data());
+  REQUIRE(fixed.decode<CaptureHeader::frame_no>() == 43);
+
+  auto view = frame.view<CaptureHeader>();
+  REQUIRE(view.data() == frame.bytes.data());
+  REQUIRE(view.decode<CaptureHeader::frame_no>() == 43);
+
+  capture->advise_random();
+  capture->prefetch(90, 10);
+
+  uint32_t expected = 0;
+  std::size_t offset = 0;
+  for (auto f : *capture) {
+    REQUIRE(f.decode<CaptureHeader::frame_no>() == expected);
+    REQUIRE(capture->offset(expected) == offset);
+    offset += f.size();
+    expected++;
+  }
+  REQUIRE(expected == 100);
+}
+
+TEST_CASE("CaptureFileTruncated", "[capture]") {
+  std::vector<std::byte> content;
+  append_frame(content, 24, 0);
+  append_frame(content, 32, 1);
+  // last frame cut short
+  append_frame(content, 40, 2);
+  content.resize(content.size() - 10);
+
+  TempFile file{content};
+
+  auto capture = Capture::open(file.path.c_str());
+  REQUIRE(capture);
+  REQUIRE(capture->size() == 2);
+  REQUIRE(capture->trailing() == 30);
+
+  // writes go to the private mapping, not to the file
+  CaptureHeader::frame_no{(*capture)[1].header()}.write(7);
+  REQUIRE((*capture)[1].decode<CaptureHeader::frame_no>() == 7);
+
+  auto again = Capture::open(file.path.c_str());
+  REQUIRE(again);
+  REQUIRE((*again)[1].decode<CaptureHeader::frame_no>() == 1);
+
+  Capture moved = std::move(*again);
+  REQUIRE(moved.size() == 2);
+}
+
+TEST_CASE("CaptureFileMissing", "[capture]") {
+  REQUIRE_FALSE(Capture::open("/nonexistent/capture.bin"));
+
+  TempFile empty{{}};
+  auto capture = Capture::open(empty.path.c_str());
+  REQUIRE(capture);
+  REQUIRE(capture->empty());
+  REQUIRE(capture->begin() == capture->end());
+}
@@ -0,0 +1,165 @@
+#include <FrameStream.h>
+#include <RegisterPack.h>
+
+#include <catch2/catch_all.hpp>
+
+#include <vector>
+
+using namespace regs;
+
+struct StreamHeader : public RegisterPack<16> {
+  using RegisterPack::RegisterPack;
+
+  struct Magic0 : public PackedRegister<StreamHeader, Magic0, 0, uint32_t> {};
+  struct Magic1 : public PackedRegister<StreamHeader, Magic1, 4, uint32_t> {};
+  struct total_length
+      : public PackedRegister<StreamHeader, total_length, 8, uint32_t> {};
+  struct frame_no
+      : public PackedRegister<StreamHeader, frame_no, 12, uint32_t> {};
+};
+
+static constexpr byte_array<8> kMagic = {0x02_b, 0x01_b, 0x04_b, 0x03_b,
+                                         0x06_b, 0x05_b, 0x08_b, 0x07_b};
+
+using Stream = FrameStream<StreamHeader, StreamHeader::total_length, 64>;
+
+struct NetHeader : public RegisterPack<12> {
+  using RegisterPack::RegisterPack;
+
+  struct Magic : public PackedRegister<NetHeader, Magic, 0, uint32_t> {};
+  struct total_length
+      : public PackedRegister<NetHeader, total_length, 4, uint32_t,
+                              std::endian::big> {};
+  struct frame_no
+      : public PackedRegister<NetHeader, frame_no, 8, uint16_t,
+                              std::endian::big> {};
+};
+
+using NetStream = FrameStream<NetHeader, NetHeader::total_length, 64, 4>;
+
+/**
+ * @brief frame of length bytes, header followed by a counting payload
+ *
+ */
+static std::vector<std::byte> make_frame(uint32_t length, uint32_t frame_no) {
+  std::vector<std::byte> frame(length);
+
+  std::copy(kMagic.begin(), kMagic.end(), frame.begin());
+  std::memcpy(frame.data() + 8, &length, 4);
+  std::memcpy(frame.data() + 12, &frame_no, 4);
+
+  for (std::size_t i = 16; i < length; i++) {
+    frame[i] = std::byte(i);
+  }
+
+  return frame;
+}
+
+TEST_CASE("FrameStreamChunks", "[stream]") {
+  Stream stream{kMagic};
+
+  auto frame = make_frame(24, 7);
+
+  REQUIRE(stream.push(std::span{frame}.first(5)) == 5);
+  REQUIRE_FALSE(stream.next());
+
+  REQUIRE(stream.push(std::span{frame}.subspan(5, 14)) == 14);
+  REQUIRE_FALSE(stream.next());
+
+  REQUIRE(stream.push(std::span{frame}.subspan(19)) == 5);
+
+  auto view = stream.next();
+  REQUIRE(view);
+  REQUIRE(view->size() == 24);
+  REQUIRE(view->decode<StreamHeader::frame_no>() == 7);
+  REQUIRE((*view)[23] == std::byte(23));
+
+  REQUIRE_FALSE(stream.next());
+  REQUIRE(stream.size() == 0);
+  REQUIRE(stream.discarded() == 0);
+}
+
+TEST_CASE("FrameStreamSync", "[stream]") {
+  Stream stream{kMagic};
+
+  std::vector<std::byte> garbage = {0x02_b, 0x01_b, 0x04_b, 0xFF_b,
+                                    0x02_b, 0x00_b, 0x13_b};
+  auto frame = make_frame(20, 1);
+
+  stream.push(garbage);
+  REQUIRE_FALSE(stream.next());
+  REQUIRE(stream.size() == 7);
+
+  stream.push(frame);
+
+  auto view = stream.next();
+  REQUIRE(view);
+  REQUIRE(view->decode<StreamHeader::frame_no>() == 1);
+  REQUIRE(stream.discarded() == garbage.size());
+
+  // a header with an implausible length is skipped
+  auto corrupt = make_frame(20, 2);
+  uint32_t huge = 1000;
+  std::memcpy(corrupt.data() + 8, &huge, 4);
+
+  frame = make_frame(20, 3);
+
+  stream.push(corrupt);
+  stream.push(frame);
+
+  view = stream.next();
+  REQUIRE(view);
+  REQUIRE(view->decode<StreamHeader::frame_no>() == 3);
+  REQUIRE(stream.discarded() == garbage.size() + corrupt.size());
+}
+
+TEST_CASE("FrameStreamBigEndian", "[stream]") {
+  NetStream stream{{0xCA_b, 0xFE_b, 0xBA_b, 0xBE_b}};
+
+  const std::vector<std::byte> frame = {0xCA_b, 0xFE_b, 0xBA_b, 0xBE_b,
+                                        0x00_b, 0x00_b, 0x00_b, 0x0C_b,
+                                        0x12_b, 0x34_b, 0x00_b, 0x00_b};
+
+  stream.push(frame);
+
+  auto view = stream.next();
+  REQUIRE(view);
+  REQUIRE(view->size() == 12);
+  REQUIRE(view->decode<NetHeader::total_length>() == 12);
+  REQUIRE(view->decode<NetHeader::frame_no>() == 0x1234);
+  REQUIRE(stream.discarded() == 0);
+}
+
+TEST_CASE("FrameStreamWrap", "[stream]") {
+  Stream stream{kMagic};
+
+  std::size_t wrapped = 0;
+
+  for (uint32_t frame_no = 0; frame_no < 10; frame_no++) {
+    auto frame = make_frame(40, frame_no);
+
+    REQUIRE(stream.push(frame) == frame.size());
+
+    auto view = stream.next();
+    REQUIRE(view);
+    REQUIRE(view->size() == 40);
+
+    if (!view->contiguous()) {
+      wrapped++;
+    }
+
+    std::vector<std::byte> copy(40);
+    view->copy_to(copy);
+
+    REQUIRE(copy == frame);
+    REQUIRE(view->decode<StreamHeader::total_length>() == 40);
+    REQUIRE(view->decode<StreamHeader::frame_no>() == frame_no);
+  }
+
+  REQUIRE(wrapped > 0);
+
+  // buffer full
+  auto frame = make_frame(40, 0);
+  REQUIRE(stream.push(frame) == 40);
+  REQUIRE(stream.push(frame) == 24);
+}
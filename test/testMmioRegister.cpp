@@ -0,0 +1,181 @@
+#include <MmioRegister.h>
+#include <RegisterArray.h>
+
+#include <catch2/catch_all.hpp>
+
+#include <ios>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace regs;
+
+/**
+ * @brief anonymous page standing in for device memory, mapped once
+ *
+ * @return pointer to the mapped page, nullptr if mmap failed
+ */
+static volatile std::uint32_t *device_page() {
+  static void *page = [] {
+    auto *mapped = ::mmap(nullptr,
+                          static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)),
+                          PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                          -1, 0);
+    return mapped == MAP_FAILED ? nullptr : mapped;
+  }();
+
+  return static_cast<volatile std::uint32_t *>(page);
+}
+
+/**
+ * @brief address used for the registers at a fixed address, not available on
+ * every host, e.g. under AddressSanitizer or with a small address space
+ *
+ */
+static constexpr std::uintptr_t kFixedBase = 0x40000000000;
+
+/**
+ * @brief map an anonymous page at kFixedBase, once
+ *
+ * @return pointer to the mapped page, nullptr if the address is not available
+ */
+static volatile std::uint32_t *fixed_page() {
+  static void *page = [] {
+    auto *mapped = ::mmap(reinterpret_cast<void *>(kFixedBase),
+                          static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)),
+                          PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+                          -1, 0);
+    return mapped == reinterpret_cast<void *>(kFixedBase) ? mapped : nullptr;
+  }();
+
+  return static_cast<volatile std::uint32_t *>(page);
+}
+
+struct GPIO_Ctrl;
+
+struct GPIO_Ctrl : MappedRegister<GPIO_Ctrl, uint32_t, 0> {
+  using MappedRegister::MappedRegister;
+
+  using FuncSel = Field<GPIO_Ctrl, 0, 5>;
+  using OutOver = Field<GPIO_Ctrl, 8, 2>;
+
+  enum class OE_OverValue {
+    OE_FromPeri = 0b00,
+    InvertedOE_FromPeri = 0b01,
+    Disable = 0b10,
+    Enable = 0b11
+  };
+
+  using OE_Over = Field<GPIO_Ctrl, 12, 2, 0, read_write, OE_OverValue>;
+
+  using Status = Field<GPIO_Ctrl, 24, 8, 0, read_only, uint8_t>;
+};
+
+struct Slots;
+
+struct Slots : MappedRegister<Slots, uint32_t, 4> {
+  using MappedRegister::MappedRegister;
+
+  using Slot = FieldArray<Slots, 0, 8, 4, 8, 0, read_write, uint8_t>;
+};
+
+struct FixedCtrl;
+
+struct FixedCtrl : MmioRegister<FixedCtrl, uint32_t, kFixedBase + 8> {
+  using FuncSel = Field<FixedCtrl, 0, 5>;
+  using Status = Field<FixedCtrl, 24, 8, 0, read_only, uint8_t>;
+};
+
+TEST_CASE("MmioFields", "[mmio]") {
+  auto *device = device_page();
+  REQUIRE(device != nullptr);
+
+  device[0] = 0xA5000000;
+
+  GPIO_Ctrl ctrl{device};
+
+  REQUIRE(ctrl.read<GPIO_Ctrl::Status>() == 0xA5);
+  REQUIRE(ctrl.is<GPIO_Ctrl::FuncSel, 0>());
+
+  ctrl.write<GPIO_Ctrl::FuncSel>(0x1F);
+  ctrl.write<GPIO_Ctrl::OutOver, 0b11>();
+  ctrl.write<GPIO_Ctrl::OE_Over>(GPIO_Ctrl::OE_OverValue::Disable);
+
+  REQUIRE(device[0] == 0xA500231F);
+
+  REQUIRE(ctrl.read<GPIO_Ctrl::FuncSel>() == 0x1F);
+  REQUIRE(ctrl.is<GPIO_Ctrl::OutOver, 0b11>());
+  REQUIRE(ctrl.read<GPIO_Ctrl::OE_Over>() == GPIO_Ctrl::OE_OverValue::Disable);
+
+  device[0] = 0x00003000;
+
+  REQUIRE(ctrl.is<GPIO_Ctrl::OE_Over, GPIO_Ctrl::OE_OverValue::Enable>());
+  REQUIRE(ctrl.read() == 0x00003000);
+
+  ctrl.write(0x12345678);
+  REQUIRE(device[0] == 0x12345678);
+}
+
+TEST_CASE("MmioModify", "[mmio]") {
+  auto *device = device_page();
+  REQUIRE(device != nullptr);
+
+  device[0] = 0xA5000000;
+
+  GPIO_Ctrl ctrl{device};
+
+  ctrl.modify<GPIO_Ctrl::FuncSel, GPIO_Ctrl::OutOver, GPIO_Ctrl::OE_Over>(
+      0x05, 0b10, GPIO_Ctrl::OE_OverValue::Enable);
+
+  REQUIRE(device[0] == 0xA5003205);
+
+  ctrl.write<GPIO_Ctrl::FuncSel::Value<0x1F>, GPIO_Ctrl::OutOver::Value<0b01>>();
+
+  REQUIRE(device[0] == 0xA500311F);
+
+  auto [func, over, status] =
+      ctrl.read_fields<GPIO_Ctrl::FuncSel, GPIO_Ctrl::OutOver,
+                       GPIO_Ctrl::Status>();
+
+  REQUIRE(func == 0x1F);
+  REQUIRE(over == 0b01);
+  REQUIRE(status == 0xA5);
+}
+
+TEST_CASE("MmioFieldArray", "[mmio]") {
+  auto *device = device_page();
+  REQUIRE(device != nullptr);
+
+  device[1] = 0x44332211;
+
+  Slots slots{device};
+
+  REQUIRE(slots.read<Slots::Slot, 0>() == 0x11);
+  REQUIRE(slots.read<Slots::Slot>(3) == 0x44);
+  REQUIRE(slots.is<Slots::Slot, 2, 0x33>());
+
+  slots.write<Slots::Slot, 1>(0xAA);
+  slots.write<Slots::Slot>(2, 0xBB);
+
+  REQUIRE(device[1] == 0x44BBAA11);
+}
+
+TEST_CASE("MmioFixedAddress", "[mmio]") {
+  auto *device = fixed_page();
+  if (device == nullptr) {
+    WARN("address 0x" << std::hex << kFixedBase
+                      << " not available, test skipped");
+    return;
+  }
+
+  device[2] = 0xA5000000;
+
+  FixedCtrl ctrl;
+
+  REQUIRE(ctrl.read<FixedCtrl::Status>() == 0xA5);
+
+  ctrl.write<FixedCtrl::FuncSel>(0x1F);
+  REQUIRE(device[2] == 0xA500001F);
+  REQUIRE(FixedCtrl::pointer() == device + 2);
+}
@@ -74,6 +74,8 @@ struct GPIO_Ctrl : Register<GPIO_Ctrl, uint32_t> {
 
   };
 
+  using Status = Field<GPIO_Ctrl, 24, 4, 0, read_only>;
+
   using IrqOver = Field<GPIO_Ctrl, 28, 2>;
 };
 
@@ -106,6 +108,52 @@ struct Trivial : Register<Trivial, uint32_t> {
 
 };
 
+struct Pins;
+
+struct Pins : Register<Pins, uint64_t> {
+  using Register::Register;
+
+  using Bit = FieldArray<Pins, 0, 1, 64>;
+  using Nibble = FieldArray<Pins, 0, 4, 16>;
+  using Control = FieldArray<Pins, 4, 3, 8, 8, 0, read_write, uint8_t>;
+  // whole bytes, but narrower than the uint64_t value type
+  using Half = FieldArray<Pins, 0, 16, 4>;
+  using Inputs = FieldArray<Pins, 32, 4, 4, 4, 0, read_only, uint8_t>;
+};
+
+struct Samples {
+  uint8_t values[3];
+};
+
+struct Sensor;
+
+// no native word, runtime indexes go through the field tables
+struct Sensor : Register<Sensor, Samples> {
+  using Register::Register;
+
+  using Raw = FieldArray<Sensor, 0, 8, 3, 8, 0, read_only, uint8_t>;
+};
+
+template <typename Reg, typename... TFields>
+concept can_modify = requires(Reg reg, typename TFields::value_type... values) {
+  reg.template modify<TFields...>(values...);
+};
+
+template <typename Reg, typename TArray>
+concept can_write_array =
+    requires(Reg reg, std::size_t index, typename TArray::value_type value) {
+      reg.template write<TArray>(index, value);
+    } ||
+    requires(Reg reg, std::span<const typename TArray::value_type> values) {
+      reg.template write_all<TArray>(values);
+    } ||
+    requires(Reg reg, typename TArray::value_type value) {
+      reg.template fill<TArray>(value);
+    } ||
+    requires(std::span<std::byte> target, typename TArray::value_type value) {
+      TArray::write(target, 0, value);
+    };
+
 uint32_t raw_state;
 
 uint32_t raw_trivial;
@@ -243,6 +291,145 @@ TEST_CASE("Enums", "[regs]") {
 }
 
 
+TEST_CASE("FieldConstants", "[regs]") {
+  STATIC_REQUIRE(State::Bool1::shift == 0);
+  STATIC_REQUIRE(State::Bool1::word_mask == 0x00000001u);
+
+  STATIC_REQUIRE(State::Bits1::shift == 4);
+  STATIC_REQUIRE(State::Bits1::word_mask == 0x00000070u);
+  STATIC_REQUIRE(State::Bits1::mask[0] == std::byte{0x70});
+  STATIC_REQUIRE(State::Bits1::mask[1] == std::byte{0x00});
+
+  STATIC_REQUIRE(State::Nibble1::shift == 20);
+  STATIC_REQUIRE(State::Nibble1::word_mask == 0x03F00000u);
+  STATIC_REQUIRE(State::Nibble1::mask[2] == std::byte{0xF0});
+  STATIC_REQUIRE(State::Nibble1::mask[3] == std::byte{0x03});
+  STATIC_REQUIRE(std::is_same_v<State::Nibble1::window_type, uint16_t>);
+  STATIC_REQUIRE(State::Nibble1::window_mask == 0x03F0u);
+
+  STATIC_REQUIRE(std::is_same_v<State::Byte2::word_type, uint32_t>);
+  STATIC_REQUIRE(State::Byte2::word_mask == 0x0000FF00u);
+
+  STATIC_REQUIRE(Trivial::TrivialWord::shift == 16);
+  STATIC_REQUIRE(Trivial::TrivialWord::word_mask == 0xFFFF0000u);
+  STATIC_REQUIRE(Trivial::TrivialValue::word_mask == 0xFFFFFFFFu);
+
+  STATIC_REQUIRE(GPIO_Ctrl::IrqOver::word_mask == 0x30000000u);
+
+  STATIC_REQUIRE(State::Nibble1::extract(0x02A00000u) == 0x2A);
+  STATIC_REQUIRE(State::Nibble1::insert(0xFFFFFFFFu, 0) == 0xFC0FFFFFu);
+  STATIC_REQUIRE(GPIO_Ctrl::OE_Over::extract(0x00002000u) ==
+                 GPIO_Ctrl::OE_OverValue::Disable);
+  STATIC_REQUIRE(GPIO_Ctrl::OE_Over::insert(
+                     0u, GPIO_Ctrl::OE_OverValue::Enable) == 0x00003000u);
+
+  STATIC_REQUIRE([] {
+    byte_array<4> raw = {0x00_b, 0x00_b, 0xA0_b, 0x02_b};
+    return State::Nibble1::read_masked(std::span<const std::byte>{raw});
+  }() == 0x2A);
+
+  STATIC_REQUIRE([] {
+    byte_array<4> raw = {0xFF_b, 0xFF_b, 0xFF_b, 0xFF_b};
+    State::Bits2::write_masked(std::span{raw}, 0x5);
+    return raw[2];
+  }() == 0xF5_b);
+}
+
+TEST_CASE("Modify", "[regs]") {
+  GPIO_Ctrl ctrl;
+
+  ctrl.write<GPIO_Ctrl::IrqOver>(0b11);
+
+  ctrl.modify<GPIO_Ctrl::FuncSel, GPIO_Ctrl::OutOver, GPIO_Ctrl::OE_Over,
+              GPIO_Ctrl::InOver>(0x15, GPIO_Ctrl::OutOver::High,
+                                 GPIO_Ctrl::OE_OverValue::Disable,
+                                 GPIO_Ctrl::InOver::Low);
+
+  REQUIRE(ctrl.read<GPIO_Ctrl::FuncSel>() == 0x15);
+  REQUIRE(ctrl.is<GPIO_Ctrl::OutOver, GPIO_Ctrl::OutOver::High>());
+  REQUIRE(ctrl.read<GPIO_Ctrl::OE_Over>() == GPIO_Ctrl::OE_OverValue::Disable);
+  REQUIRE(ctrl.read<GPIO_Ctrl::InOver>() == GPIO_Ctrl::InOver::Low);
+  REQUIRE(ctrl.read<GPIO_Ctrl::IrqOver>() == 0b11);
+
+  ctrl.write<GPIO_Ctrl::FuncSel::Value<0x03>,
+             GPIO_Ctrl::OutOver::Value<GPIO_Ctrl::OutOver::Low>,
+             GPIO_Ctrl::InOver::Value<GPIO_Ctrl::InOver::High>>();
+
+  REQUIRE(ctrl.read<GPIO_Ctrl::FuncSel>() == 0x03);
+  REQUIRE(ctrl.is<GPIO_Ctrl::OutOver, GPIO_Ctrl::OutOver::Low>());
+  REQUIRE(ctrl.read<GPIO_Ctrl::OE_Over>() == GPIO_Ctrl::OE_OverValue::Disable);
+  REQUIRE(ctrl.read<GPIO_Ctrl::InOver>() == GPIO_Ctrl::InOver::High);
+  REQUIRE(ctrl.read<GPIO_Ctrl::IrqOver>() == 0b11);
+
+  STATIC_REQUIRE(can_modify<GPIO_Ctrl, GPIO_Ctrl::FuncSel, GPIO_Ctrl::IrqOver>);
+  STATIC_REQUIRE_FALSE(can_modify<GPIO_Ctrl, GPIO_Ctrl::FuncSel, State::Bool1>);
+  STATIC_REQUIRE_FALSE(can_modify<GPIO_Ctrl, GPIO_Ctrl::Status>);
+}
+
+TEST_CASE("BitOps", "[regs]") {
+  State state;
+
+  state.write<State::Bits1>(0b101);
+
+  state.set<State::Bool2>();
+  REQUIRE(state.test<State::Bool2>());
+  REQUIRE_FALSE(state.test<State::Bool1>());
+  REQUIRE(state.read<State::Bits1>() == 0b101);
+
+  state.set<State::Bool1, State::Bool3, State::Bits2>();
+  REQUIRE(state.test<State::Bool1, State::Bool2, State::Bool3>());
+  REQUIRE(state.read<State::Bits2>() == 0xF);
+  REQUIRE(state.read() == 0x000F0057);
+
+  state.clear<State::Bool1, State::Bits2>();
+  REQUIRE_FALSE(state.test<State::Bool1, State::Bool2>());
+  REQUIRE(state.read() == 0x00000056);
+
+  state.toggle<State::Bool2>();
+  REQUIRE_FALSE(state.test<State::Bool2>());
+  state.toggle<State::Bits1, State::Bool1>();
+  REQUIRE(state.read<State::Bits1>() == 0b010);
+  REQUIRE(state.read() == 0x00000025);
+
+  // a field test is true only with all bits set
+  REQUIRE_FALSE(state.test<State::Bits1>());
+  state.set<State::Bits1>();
+  REQUIRE(state.test<State::Bits1>());
+}
+
+TEST_CASE("ReadFields", "[regs]") {
+  raw_state = 0x02AF2F23;
+
+  State *new_state = new (&raw_state) State(noInit{});
+
+  auto [bool1, bool2, bits1, byte2, bits2, nibble1] =
+      new_state->read_fields<State::Bool1, State::Bool2, State::Bits1,
+                             State::Byte2, State::Bits2, State::Nibble1>();
+
+  STATIC_REQUIRE(std::is_same_v<decltype(byte2), uint8_t>);
+
+  REQUIRE(bool1 == 1);
+  REQUIRE(bool2 == 1);
+  REQUIRE(bits1 == 2);
+  REQUIRE(byte2 == 0x2F);
+  REQUIRE(bits2 == 0x0F);
+  REQUIRE(nibble1 == 0b101010);
+
+  GPIO_Ctrl ctrl;
+
+  ctrl.modify<GPIO_Ctrl::OutOver, GPIO_Ctrl::OE_Over, GPIO_Ctrl::InOver>(
+      GPIO_Ctrl::OutOver::High, GPIO_Ctrl::OE_OverValue::Enable,
+      GPIO_Ctrl::InOver::InvertedPeriInput);
+
+  auto [out, oe, in] =
+      ctrl.read_fields<GPIO_Ctrl::OutOver, GPIO_Ctrl::OE_Over,
+                       GPIO_Ctrl::InOver>();
+
+  REQUIRE(out == GPIO_Ctrl::OutOver::High);
+  REQUIRE(oe == GPIO_Ctrl::OE_OverValue::Enable);
+  REQUIRE(in == GPIO_Ctrl::InOver::InvertedPeriInput);
+}
+
 TEST_CASE("Trivial", "[regs]") {
   
   raw_trivial = 0x04030201;
@@ -304,4 +491,141 @@ TEST_CASE("Trivial", "[regs]") {
   REQUIRE(new_trivial->read<Trivial::ByteArray>(3) == 0xAA);
 
 
-}
\ No newline at end of file
+}
+
+TEST_CASE("FieldArrayRuntime", "[regs]") {
+  Pins pins;
+
+  for (std::size_t i = 0; i < Pins::Bit::count; i += 3) {
+    pins.write<Pins::Bit>(i, 1);
+  }
+
+  for (std::size_t i = 0; i < Pins::Bit::count; i++) {
+    REQUIRE(pins.read<Pins::Bit>(i) == (i % 3 == 0 ? 1u : 0u));
+  }
+
+  REQUIRE(pins.read<Pins::Bit, 63>() == 1);
+  REQUIRE(pins.read<Pins::Nibble>(15) == 0b1001);
+
+  pins.write<Pins::Nibble>(15, 0);
+  pins.write<Pins::Nibble>(0, 0);
+
+  for (std::size_t i = 0; i < Pins::Control::count; i++) {
+    pins.write<Pins::Control>(i, static_cast<uint8_t>(i));
+  }
+
+  for (std::size_t i = 0; i < Pins::Control::count; i++) {
+    REQUIRE(pins.read<Pins::Control>(i) == i);
+  }
+
+  REQUIRE(pins.read<Pins::Control, 7>() == 7);
+  REQUIRE(pins.read<Pins::Nibble>(15) == 0b0111);
+  REQUIRE(pins.read<Pins::Nibble>(0) == 0);
+
+  pins.write<Pins::Half, 2>(0xBEEF);
+  REQUIRE(pins.read<Pins::Half, 2>() == 0xBEEF);
+  REQUIRE(pins.read<Pins::Half>(2) == 0xBEEF);
+}
+
+TEST_CASE("ReadOnlyFieldArray", "[regs]") {
+  Pins pins;
+  pins.write(0x0000'4321'0000'0000);
+
+  REQUIRE(pins.read<Pins::Inputs>(0) == 1);
+  REQUIRE(pins.read<Pins::Inputs>(3) == 4);
+  REQUIRE(pins.read<Pins::Inputs, 2>() == 3);
+
+  Sensor sensor;
+  sensor.write(Samples{{7, 8, 9}});
+
+  REQUIRE(sensor.read<Sensor::Raw>(0) == 7);
+  REQUIRE(sensor.read<Sensor::Raw>(2) == 9);
+  REQUIRE(sensor.read<Sensor::Raw, 1>() == 8);
+
+  STATIC_REQUIRE(can_write_array<Pins, Pins::Control>);
+  STATIC_REQUIRE_FALSE(can_write_array<Pins, Pins::Inputs>);
+  STATIC_REQUIRE_FALSE(can_write_array<Sensor, Sensor::Raw>);
+}
+
+#if defined(NDEBUG)
+TEST_CASE("FieldArrayOutOfRange", "[regs]") {
+  // without assertions out of range indexes read zero and write nothing
+  Pins pins;
+  pins.write(0x0123456789ABCDEF);
+
+  REQUIRE(pins.read<Pins::Nibble>(16) == 0);
+  REQUIRE(pins.read<Pins::Bit>(1000) == 0);
+
+  pins.write<Pins::Nibble>(16, 0xF);
+  pins.write<Pins::Control>(8, 7);
+  REQUIRE(pins.read() == 0x0123456789ABCDEF);
+
+  const std::array<uint8_t, 9> values = {1, 1, 1, 1, 1, 1, 1, 1, 1};
+  pins.write_all<Pins::Control>(values);
+  REQUIRE(pins.read() == 0x11131517'999B9D9F);
+
+  Sensor sensor;
+  sensor.write(Samples{{7, 8, 9}});
+  REQUIRE(sensor.read<Sensor::Raw>(3) == 0);
+}
+#endif
+
+TEST_CASE("FieldArrayBulk", "[regs]") {
+  Pins pins;
+
+  pins.fill<Pins::Control>(0b101);
+
+  for (auto value : pins.read_all<Pins::Control>()) {
+    REQUIRE(value == 0b101);
+  }
+
+  REQUIRE(pins.read() == 0x5050505050505050);
+
+  const std::array<uint8_t, 3> first = {1, 2, 3};
+  pins.write_all<Pins::Control>(first);
+
+  auto controls = pins.read_all<Pins::Control>();
+
+  REQUIRE(controls[0] == 1);
+  REQUIRE(controls[1] == 2);
+  REQUIRE(controls[2] == 3);
+  REQUIRE(controls[3] == 0b101);
+
+  std::size_t visited = 0;
+  unsigned sum = 0;
+
+  pins.for_each<Pins::Control>([&](std::size_t index, uint8_t value) {
+    REQUIRE(index == visited++);
+    sum += value;
+  });
+
+  REQUIRE(visited == Pins::Control::count);
+  REQUIRE(sum == 1 + 2 + 3 + 5 * 5);
+
+  Trivial trivial;
+
+  trivial.fill<Trivial::ByteArray>(0xA5);
+  REQUIRE(trivial.read<Trivial::TrivialValue>() == 0xA5A5A5A5);
+}
+
+TEST_CASE("Constexpr", "[regs]") {
+  constexpr auto configured = [] {
+    State state;
+    state.write<State::Bits1>(5);
+    state.write<State::Byte2>(0xA5);
+    state.set<State::Bool3>();
+    state.modify<State::Bool1, State::Nibble1>(1, 0x2A);
+    return state.read();
+  }();
+  STATIC_REQUIRE(configured == 0x02A0A555);
+
+  constexpr auto fields = [] {
+    State state;
+    state.write(configured);
+    return std::tuple{state.read<State::Nibble1>(), state.test<State::Bool2>(),
+                      state.is<State::Bits1, 5>()};
+  }();
+  STATIC_REQUIRE(std::get<0>(fields) == 0x2A);
+  STATIC_REQUIRE_FALSE(std::get<1>(fields));
+  STATIC_REQUIRE(std::get<2>(fields));
+}
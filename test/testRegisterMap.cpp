@@ -0,0 +1,212 @@
+#include <Register.h>
+#include <RegisterArray.h>
+#include <RegisterMap.h>
+#include <RegisterPack.h>
+
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace regs;
+
+struct Ctrl;
+
+struct Ctrl : Register<Ctrl, uint32_t> {
+  using Enable = Field<Ctrl, 0, 1>;
+  using Mode = Field<Ctrl, 1, 3, 0, read_only>;
+  using Lane = FieldArray<Ctrl, 8, 4, 4, 4, 0, read_write, uint8_t>;
+  using Trigger = Field<Ctrl, 31, 1, 0, write_only>;
+
+  // overlaps Mode
+  using Wrong = Field<Ctrl, 3, 2>;
+};
+
+using CtrlMap =
+    FieldMap<Ctrl, Ctrl::Enable, Ctrl::Mode, Ctrl::Lane, Ctrl::Trigger>;
+
+struct Device : RegisterPack<32> {
+  using RegisterPack::RegisterPack;
+
+  struct Id : PackedRegister<Device, Id, 0, uint32_t> {};
+  struct Status : PackedRegister<Device, Status, 4, uint16_t> {};
+
+  template <unsigned Offset>
+  struct Channel : PackedRegister<Device, Channel<Offset>, Offset, uint32_t> {};
+
+  using Channels = RegisterArray<Channel, 8, 4>;
+
+  // overlaps Status
+  struct Wrong : PackedRegister<Device, Wrong, 5, uint16_t> {};
+};
+
+using DeviceMap =
+    RegisterMap<Device, Device::Id, Device::Status, Device::Channels>;
+
+TEST_CASE("FieldMap", "[map]") {
+  STATIC_REQUIRE(CtrlMap::count == 4);
+
+  STATIC_REQUIRE(CtrlMap::fields[1].offset == 1);
+  STATIC_REQUIRE(CtrlMap::fields[1].width == 3);
+  STATIC_REQUIRE(CtrlMap::fields[1].access == access_kind::read_only);
+
+  STATIC_REQUIRE(CtrlMap::fields[2].offset == 8);
+  STATIC_REQUIRE(CtrlMap::fields[2].width == 16);
+  STATIC_REQUIRE(CtrlMap::fields[3].access == access_kind::write_only);
+
+  STATIC_REQUIRE(CtrlMap::name.ends_with("Ctrl"));
+  // aliases have no name of their own, the field is spelled out
+  STATIC_REQUIRE(CtrlMap::fields[0].name.find("Field<") !=
+                 std::string_view::npos);
+
+  STATIC_REQUIRE(
+      details::fields_disjoint<Ctrl::Enable, Ctrl::Mode, Ctrl::Lane>);
+  STATIC_REQUIRE_FALSE(details::fields_disjoint<Ctrl::Mode, Ctrl::Wrong>);
+  STATIC_REQUIRE_FALSE(details::fields_disjoint<Ctrl::Lane, Ctrl::Lane>);
+
+  Ctrl ctrl;
+  ctrl.write<Ctrl::Enable>(1);
+  ctrl.write<Ctrl::Lane>(2, 0xA);
+
+  std::vector<std::string> dump;
+
+  CtrlMap::for_each([&](auto field, const field_info &info) {
+    using TField = typename decltype(field)::type;
+    if constexpr (!details::is_field_array<TField> &&
+                  details::is_readable<typename TField::access>) {
+      dump.push_back(std::string{info.name} + "=" +
+                     std::to_string(ctrl.read<TField>()));
+    }
+  });
+
+  REQUIRE(dump.size() == 2);
+  REQUIRE(dump[0].ends_with("=1"));
+  REQUIRE(dump[1].ends_with("=0"));
+}
+
+TEST_CASE("RegisterMap", "[map]") {
+  STATIC_REQUIRE(DeviceMap::count == 3);
+  STATIC_REQUIRE(DeviceMap::registers[1].offset == 4);
+  STATIC_REQUIRE(DeviceMap::registers[1].size == 2);
+  STATIC_REQUIRE(DeviceMap::registers[2].offset == 8);
+  STATIC_REQUIRE(DeviceMap::registers[2].size == 16);
+  STATIC_REQUIRE(DeviceMap::unmapped == 32 - 4 - 2 - 16);
+
+  STATIC_REQUIRE(DeviceMap::registers[0].name.ends_with("Id"));
+
+  STATIC_REQUIRE(
+      details::registers_disjoint<Device::Id, Device::Status, Device::Channels>);
+  STATIC_REQUIRE_FALSE(
+      details::registers_disjoint<Device::Status, Device::Wrong>);
+
+  std::size_t covered = 0;
+  DeviceMap::for_each(
+      [&](auto, const register_info &info) { covered += info.size; });
+
+  REQUIRE(covered == 22);
+}
+
+struct Timer;
+
+struct Timer : Register<Timer, uint32_t> {
+  enum class Mode : uint8_t { OneShot, Periodic, Capture };
+
+  using Enable = Field<Timer, 0, 1, 0, read_write, uint32_t, 1>;
+  using Prescaler = Field<Timer, 4, 4, 0, read_write, uint8_t, 7>;
+  using TimerMode = Field<Timer, 8, 2, 0, read_write, Mode, Mode::Periodic>;
+  using Status = Field<Timer, 12, 1, 0, read_only>;
+  using Channels = FieldArray<Timer, 16, 2, 4, 2, 0, read_write, uint8_t, 2>;
+
+  using field_map =
+      FieldMap<Timer, Enable, Prescaler, TimerMode, Status, Channels>;
+};
+
+struct Block : RegisterPack<32> {
+  using RegisterPack::RegisterPack;
+
+  struct Config
+      : PackedRegister<Block, Config, 0, uint32_t, std::endian::big> {
+    using Speed = Field<Config, 0, 8, 0, read_write, uint8_t, 0x12>;
+    using Flags = Field<Config, 24, 8, 0, read_write, uint8_t, 0xA5>;
+
+    using field_map = FieldMap<Config, Speed, Flags>;
+  };
+
+  template <unsigned Offset>
+  struct Slot : PackedRegister<Block, Slot<Offset>, Offset, uint16_t> {
+    using Level = Field<Slot, 0, 12, 0, read_write, uint16_t, 0x3FF>;
+
+    using field_map = FieldMap<Slot, Level>;
+  };
+
+  using Slots = RegisterArray<Slot, 4, 4>;
+
+  struct WideValue {
+    uint32_t words[3];
+  };
+
+  // no native word, reset values are written byte wise
+  struct Wide : PackedRegister<Block, Wide, 16, WideValue> {
+    using Gain = Field<Wide, 4, 8, 4, read_write, uint8_t, 0x5A>;
+
+    using field_map = FieldMap<Wide, Gain>;
+  };
+
+  // no field map, resets to zero
+  struct Scratch : PackedRegister<Block, Scratch, 28, uint32_t> {};
+};
+
+using BlockMap = RegisterMap<Block, Block::Config, Block::Slots, Block::Wide,
+                             Block::Scratch>;
+
+TEST_CASE("ResetValues", "[map]") {
+  STATIC_REQUIRE(Timer::Prescaler::reset_value == 7);
+  STATIC_REQUIRE(Timer::Channels::field<3>::reset_value == 2);
+  STATIC_REQUIRE(Timer::reset_value() == 0x00AA0171);
+  STATIC_REQUIRE(Ctrl::reset_value() == 0);
+
+  Timer timer;
+  timer.write(0xFFFFFFFF);
+  timer.reset();
+  REQUIRE(timer.read() == 0x00AA0171);
+  REQUIRE(timer.read<Timer::TimerMode>() == Timer::Mode::Periodic);
+
+  timer.write(0xFFFFFFFF);
+  timer.init<Timer::Prescaler::Value<3>, Timer::Enable::Value<0>>();
+  REQUIRE(timer.read() == 0x00AA0130);
+
+  STATIC_REQUIRE(Block::Config::reset_value() == 0xA5000012);
+  STATIC_REQUIRE(Block::Wide::reset_value().words[1] == 0x5A0);
+}
+
+TEST_CASE("ResetAll", "[map]") {
+  constexpr auto &image = BlockMap::reset_image;
+
+  // big endian Config
+  STATIC_REQUIRE(image[0] == 0xA5_b);
+  STATIC_REQUIRE(image[3] == 0x12_b);
+  // every Slot
+  STATIC_REQUIRE(image[4] == 0xFF_b);
+  STATIC_REQUIRE(image[5] == 0x03_b);
+  STATIC_REQUIRE(image[10] == 0xFF_b);
+  STATIC_REQUIRE(image[11] == 0x03_b);
+  STATIC_REQUIRE(image[20] == 0xA0_b);
+  STATIC_REQUIRE(image[21] == 0x05_b);
+  STATIC_REQUIRE(image[28] == 0_b);
+
+  Block block;
+  std::fill(block._target.begin(), block._target.end(), 0xEE_b);
+
+  BlockMap::reset_all(block);
+  REQUIRE(std::equal(image.begin(), image.end(), block._target.begin()));
+  REQUIRE(Block::Config{block}.read<Block::Config::Flags>() == 0xA5);
+  REQUIRE(Block::Slots::read(block, 1) == 0x3FF);
+
+  std::array<std::byte, 40> buffer;
+  buffer.fill(0xEE_b);
+  BlockMap::reset_all(
+      PackView<Block, std::dynamic_extent>{std::span{buffer}.subspan(4)});
+  REQUIRE(buffer[3] == 0xEE_b);
+  REQUIRE(buffer[4] == 0xA5_b);
+  REQUIRE(buffer[36] == 0xEE_b);
+}
@@ -49,6 +49,23 @@ struct ArrayRegister
 
 using ByteRegisters = RegisterArray<ArrayRegister, 0, 8, 1>;
 
+struct WidePack : public RegisterPack<16> {
+  using RegisterPack::RegisterPack;
+};
+
+struct WideValue {
+  uint32_t words[4];
+};
+
+struct Wide : public PackedRegister<WidePack, Wide, 0, WideValue> {
+  using PackedRegister::PackedRegister;
+
+  using Words = FieldArray<Wide, 0, 32, 4, 32, 0, read_write, uint32_t>;
+
+  using Flag = Field<Wide, 3, 1, 12, read_write, uint8_t>;
+  using Span = Field<Wide, 4, 62, 4, read_write, uint8_t>;
+};
+
 std::byte raw_set[8] = {0x03_b, 0x11_b, 0_b, 0_b, 1_b, 0_b, 0_b, 0_b};
 
 TEST_CASE("RegSet", "[regs]") {
@@ -96,3 +113,293 @@ TEST_CASE("RegisterArray", "[regs]") {
   ByteRegisters::write(*reg_set, 6, 0x6A);
   REQUIRE(ByteRegisters::read(*reg_set, 6) == 0x6A);
 }
+
+TEST_CASE("WideFieldArray", "[regs]") {
+  WidePack pack;
+
+  Wide wide{pack};
+
+  for (std::size_t i = 0; i < Wide::Words::count; i++) {
+    wide.write<Wide::Words>(i, 0x11111111u * static_cast<uint32_t>(i + 1));
+  }
+
+  REQUIRE(wide.read<Wide::Words>(0) == 0x11111111u);
+  REQUIRE(wide.read<Wide::Words>(3) == 0x44444444u);
+  REQUIRE(wide.read<Wide::Words, 2>() == 0x33333333u);
+  REQUIRE(wide.read().words[1] == 0x22222222u);
+}
+
+TEST_CASE("WideBitOps", "[regs]") {
+  WidePack pack;
+  Wide wide{pack};
+
+  wide.set<Wide::Flag>();
+  REQUIRE(pack._target[12] == 0x08_b);
+  REQUIRE(wide.test<Wide::Flag>());
+
+  // wider than a native word, handled byte by byte
+  wide.set<Wide::Span>();
+  REQUIRE(wide.test<Wide::Span>());
+  REQUIRE(pack._target[4] == 0xF0_b);
+  REQUIRE(pack._target[12] == 0x0B_b);
+
+  wide.toggle<Wide::Flag, Wide::Span>();
+  REQUIRE_FALSE(wide.test<Wide::Flag>());
+  REQUIRE(pack._target[4] == 0x00_b);
+  REQUIRE(pack._target[12] == 0x00_b);
+
+  wide.clear<Wide::Span>();
+  wide.toggle<Wide::Flag>();
+  REQUIRE(wide.read<Wide::Words, 3>() == 0x00000008);
+  REQUIRE(wide.read<Wide::Words, 1>() == 0);
+}
+
+TEST_CASE("RegisterArrayBulk", "[regs]") {
+  TestRegisterPack pack;
+
+  ByteRegisters::fill(pack, 0x11);
+
+  for (auto value : ByteRegisters::read_all(pack)) {
+    REQUIRE(value == 0x11);
+  }
+
+  const std::array<uint8_t, 2> values = {0xA0, 0xA1};
+  ByteRegisters::write_all(pack, values);
+
+  REQUIRE(ByteRegisters::read(pack, 0) == 0xA0);
+  REQUIRE(ByteRegisters::read(pack, 1) == 0xA1);
+  REQUIRE(ByteRegisters::read(pack, 2) == 0x11);
+
+  ByteRegisters::for_each(pack, [](std::size_t index, auto reg) {
+    using Value = typename decltype(reg)::Value;
+    reg.template write<Value>(static_cast<uint8_t>(index));
+  });
+
+  REQUIRE(ByteRegisters::read(pack, 0) == 0);
+  REQUIRE(ByteRegisters::read(pack, 7) == 7);
+
+  // reads only need a read-only view
+  const TestRegisterPack &owner = pack;
+  PackView<const TestRegisterPack> view{owner};
+
+  REQUIRE(ByteRegisters::read<3>(view) == 3);
+  REQUIRE(ByteRegisters::read(view, 6) == 6);
+  REQUIRE(ByteRegisters::read_all(view)[5] == 5);
+  REQUIRE(ByteRegisters::read<2>(owner) == 2);
+
+  std::array<std::byte, 12> buffer{};
+  buffer[4 + 1] = 0x5A_b;
+  auto offset = PackView<const TestRegisterPack, std::dynamic_extent>{
+      std::span<const std::byte>{buffer}.subspan(4)};
+  REQUIRE(ByteRegisters::read(offset, 1) == 0x5A);
+}
+
+#if defined(NDEBUG)
+TEST_CASE("RegisterArrayOutOfRange", "[regs]") {
+  // without assertions out of range indexes read zero and write nothing
+  std::array<std::byte, 12> buffer{};
+  buffer[8] = 0x77_b;
+  PackView<TestRegisterPack, std::dynamic_extent> pack{std::span{buffer}};
+
+  ByteRegisters::write(pack, 8, 0x55);
+  REQUIRE(buffer[8] == 0x77_b);
+  REQUIRE(ByteRegisters::read(pack, 8) == 0);
+}
+#endif
+
+struct NetworkPack : public RegisterPack<8> {
+  using RegisterPack::RegisterPack;
+};
+
+struct NetworkHeader;
+struct NetworkHeader
+    : public PackedRegister<NetworkPack, NetworkHeader, 0, uint32_t,
+                            std::endian::big> {
+  using PackedRegister::PackedRegister;
+
+  using Flags = Field<NetworkHeader, 0, 4>;
+  using Length = Field<NetworkHeader, 4, 12, 0, read_write, uint16_t>;
+  using Version = Field<NetworkHeader, 24, 8, 0, read_write, uint8_t>;
+};
+
+template <unsigned Offset>
+struct Sample : public PackedRegister<NetworkPack, Sample<Offset>, Offset,
+                                      uint16_t, std::endian::big> {
+  using PackedRegister<NetworkPack, Sample<Offset>, Offset, uint16_t,
+                       std::endian::big>::PackedRegister;
+
+  using Low = Field<Sample<Offset>, 0, 8, 0, read_write, uint8_t>;
+  using High = Field<Sample<Offset>, 8, 8, 0, read_write, uint8_t>;
+};
+
+using Samples = RegisterArray<Sample, 0, 4>;
+
+enum class Opcode : uint16_t { Nop = 0x0001, Read = 0x0102, Write = 0x0203 };
+
+template <unsigned Offset>
+struct Command : public PackedRegister<NetworkPack, Command<Offset>, Offset,
+                                       Opcode, std::endian::big> {
+  using PackedRegister<NetworkPack, Command<Offset>, Offset, Opcode,
+                       std::endian::big>::PackedRegister;
+};
+
+using Commands = RegisterArray<Command, 0, 4>;
+
+struct Status : Register<Status, uint16_t, std::endian::big> {
+  using Ready = Field<Status, 0, 1>;
+  using Code = Field<Status, 8, 8, 0, read_write, uint8_t>;
+};
+
+TEST_CASE("BigEndianRegister", "[regs]") {
+  NetworkPack pack;
+
+  NetworkHeader header{pack};
+
+  header.write(0x12345678);
+
+  REQUIRE(pack._target[0] == 0x12_b);
+  REQUIRE(pack._target[3] == 0x78_b);
+  REQUIRE(header.read() == 0x12345678);
+
+  REQUIRE(header.read<NetworkHeader::Flags>() == 0x8);
+  REQUIRE(header.read<NetworkHeader::Length>() == 0x567);
+  REQUIRE(header.read<NetworkHeader::Version>() == 0x12);
+
+  header.write<NetworkHeader::Length>(0xABC);
+  header.write<NetworkHeader::Flags, 0x1>();
+
+  REQUIRE(header.read() == 0x1234ABC1);
+  REQUIRE(pack._target[2] == 0xAB_b);
+
+  header.modify<NetworkHeader::Version, NetworkHeader::Flags>(0x20, 0x2);
+  REQUIRE(NetworkHeader::decode(pack._target) == 0x2034ABC2);
+
+  Status status;
+  status.write<Status::Code>(0x42);
+  status.write<Status::Ready>(1);
+
+  REQUIRE(status.read() == 0x4201);
+  REQUIRE(status.const_target()[0] == 0x42_b);
+  REQUIRE(status.const_target()[1] == 0x01_b);
+}
+
+TEST_CASE("BigEndianRegisterArray", "[regs]") {
+  NetworkPack pack;
+
+  Samples::write(pack, 1, 0x1234);
+  REQUIRE(pack._target[2] == 0x12_b);
+  REQUIRE(Samples::read(pack, 1) == 0x1234);
+  REQUIRE(Samples::at<1>(pack).read<Sample<2>::High>() == 0x12);
+
+  // enough samples for the vectorized swap plus a scalar tail
+  constexpr std::size_t count = 45;
+
+  std::vector<std::byte> payload(count * 2);
+  for (std::size_t i = 0; i < count; i++) {
+    payload[2 * i] = std::byte(i);
+    payload[2 * i + 1] = std::byte(0xF0 | (i & 0xF));
+  }
+
+  std::vector<uint16_t> values(count);
+  Samples::decode_all(payload, count, values);
+
+  std::vector<uint8_t> high(count), low(count);
+  Samples::decode_columns<Sample<0>::High, Sample<0>::Low>(payload, count,
+                                                           high, low);
+
+  for (std::size_t i = 0; i < count; i++) {
+    REQUIRE(values[i] == ((i << 8) | 0xF0 | (i & 0xF)));
+    REQUIRE(high[i] == i);
+    REQUIRE(low[i] == (0xF0 | (i & 0xF)));
+  }
+
+  // values that are not integers are swapped without aliasing them
+  std::vector<std::byte> opcodes;
+  for (std::size_t i = 0; i < count; i++) {
+    opcodes.push_back(0x02_b);
+    opcodes.push_back(0x03_b);
+  }
+  opcodes[0] = 0x00_b;
+  opcodes[1] = 0x01_b;
+
+  std::vector<Opcode> commands(count);
+  Commands::decode_all(opcodes, count, commands);
+
+  REQUIRE(commands[0] == Opcode::Nop);
+  for (std::size_t i = 1; i < count; i++) {
+    REQUIRE(commands[i] == Opcode::Write);
+  }
+}
+
+struct TelemetryPack : public RegisterPack<100> {
+  using RegisterPack::RegisterPack;
+};
+
+TEST_CASE("PackDelta", "[regs]") {
+  TelemetryPack pack;
+  for (std::size_t i = 0; i < 100; i++) {
+    pack._target[i] = std::byte(i);
+  }
+
+  auto before = pack.snapshot();
+  REQUIRE(TelemetryPack::diff(before, pack.snapshot()).empty());
+
+  // changes in the 32 byte, 16 byte, 8 byte and single byte parts of the scan
+  pack._target[3] = 0xFF_b;
+  pack._target[4] = 0xFF_b;
+  pack._target[31] = 0xFF_b;
+  pack._target[32] = 0xFF_b;
+  pack._target[50] = 0xFF_b;
+  pack._target[90] = 0xFF_b;
+  pack._target[99] = 0xFF_b;
+
+  auto after = pack.snapshot();
+
+  PackDelta delta;
+  TelemetryPack::diff(before, after, delta);
+
+  REQUIRE(delta.ranges() == std::vector<byte_range>{
+                                {3, 2}, {31, 2}, {50, 1}, {90, 1}, {99, 1}});
+  REQUIRE(delta.bytes().size() == 7);
+
+  TelemetryPack copy;
+  copy._target = before;
+  copy.apply(delta);
+  REQUIRE(TelemetryPack::diff(copy.snapshot(), after).empty());
+
+  // a full change is one range
+  TelemetryPack zero;
+  TelemetryPack::diff(zero.snapshot(), after, delta);
+  REQUIRE(delta.ranges() == std::vector<byte_range>{{1, 99}});
+}
+
+TEST_CASE("ConstexprPack", "[regs]") {
+  // default register block built at compile time
+  constexpr auto image = [] {
+    TestRegisterPack pack;
+    Register0{pack}.write<Register0::Byte2>(0x11);
+    Register0{pack}.set<Register0::Bool1, Register0::Bool2>();
+    Register1{pack}.write<Register1::Nibble1>(3);
+    ByteRegisters::write(pack, 7, 0x42);
+    return pack.snapshot();
+  }();
+
+  STATIC_REQUIRE(image[0] == 0x03_b);
+  STATIC_REQUIRE(image[1] == 0x11_b);
+  STATIC_REQUIRE(image[4] == std::byte{3 << 3});
+  STATIC_REQUIRE(image[7] == 0x42_b);
+  STATIC_REQUIRE(Register0::decode(image) == 0x1103);
+  STATIC_REQUIRE(ByteRegisters::decode(image, 7) == 0x42);
+  STATIC_REQUIRE(PackView<const TestRegisterPack, std::dynamic_extent>{
+      std::span{image}}.read<Register0::Byte2>() == 0x11);
+
+  constexpr auto words = [] {
+    WidePack pack;
+    Wide wide{pack};
+    wide.write<Wide::Words>(2, 0xCAFEF00Du);
+    wide.set<Wide::Flag>();
+    return std::pair{wide.read<Wide::Words>(2), wide.read<Wide::Words, 3>()};
+  }();
+  STATIC_REQUIRE(words.first == 0xCAFEF00Du);
+  STATIC_REQUIRE(words.second == 1u << 3);
+}
@@ -0,0 +1,126 @@
+#include <Register.h>
+#include <RegisterArray.h>
+#include <RegisterPack.h>
+#include <Shadowed.h>
+
+#include <catch2/catch_all.hpp>
+
+using namespace regs;
+
+struct Control;
+
+struct Control : Register<Control, uint32_t> {
+  using Register::Register;
+
+  using Enable = Field<Control, 0, 1>;
+  using Mode = Field<Control, 4, 3>;
+
+  using Trigger = Field<Control, 8, 4, 0, write_only>;
+  using Reload = Field<Control, 16, 16, 0, write_only, uint16_t>;
+};
+
+struct ConfigPack : public RegisterPack<12> {
+  using RegisterPack::RegisterPack;
+};
+
+struct Config0;
+struct Config0 : public PackedRegister<ConfigPack, Config0, 0, uint32_t> {
+  using PackedRegister::PackedRegister;
+
+  using Speed = Field<Config0, 0, 8>;
+  using Divider = Field<Config0, 8, 8>;
+};
+
+struct Config1;
+struct Config1 : public PackedRegister<ConfigPack, Config1, 4, uint32_t> {
+  using PackedRegister::PackedRegister;
+
+  using Threshold = Field<Config1, 0, 12>;
+};
+
+struct Config2;
+struct Config2 : public PackedRegister<ConfigPack, Config2, 8, uint16_t> {
+  using PackedRegister::PackedRegister;
+
+  using Flags = Field<Config2, 0, 16, 0, write_only, uint16_t>;
+};
+
+TEST_CASE("ShadowedRegister", "[shadow]") {
+  Control control;
+  control.write(0x00000010);
+
+  Shadowed<Control> shadow(control);
+
+  REQUIRE_FALSE(shadow.dirty());
+  REQUIRE(shadow.read<Control::Mode>() == 1);
+
+  shadow.write<Control::Enable>(1);
+  shadow.write<Control::Trigger>(0xA);
+  shadow.write<Control::Reload>(0x1234);
+
+  REQUIRE(shadow.dirty());
+  REQUIRE(control.read() == 0x00000010);
+
+  REQUIRE(shadow.flush());
+  REQUIRE_FALSE(shadow.dirty());
+  REQUIRE(control.read() == 0x12340A11);
+
+  REQUIRE_FALSE(shadow.flush());
+
+  shadow.modify<Control::Mode, Control::Trigger>(5, 0x3);
+  control.write(0);
+
+  shadow.pull();
+
+  REQUIRE_FALSE(shadow.dirty());
+  REQUIRE(shadow.read() == 0);
+}
+
+TEST_CASE("ShadowedPackedRegister", "[shadow]") {
+  ConfigPack pack;
+
+  Shadowed<Config2> flags(Config2{pack}, 0);
+
+  flags.write<Config2::Flags>(0xBEEF);
+
+  REQUIRE(Config2{pack}.read() == 0);
+
+  flags.flush();
+
+  REQUIRE(Config2{pack}.read() == 0xBEEF);
+}
+
+TEST_CASE("ShadowedPack", "[shadow]") {
+  ConfigPack device;
+
+  Config1{device}.write(0x00000123);
+
+  ShadowedPack<ConfigPack> shadow(device);
+
+  REQUIRE_FALSE(shadow.dirty());
+
+  Config0 config0{shadow};
+  config0.modify<Config0::Speed, Config0::Divider>(0x40, 0x02);
+
+  REQUIRE(shadow.dirty());
+  REQUIRE(shadow.dirty<Config0>());
+  REQUIRE_FALSE(shadow.dirty<Config1>());
+  REQUIRE(Config0{device}.read() == 0);
+
+  Config1 config1{shadow};
+  REQUIRE(config1.read<Config1::Threshold>() == 0x123);
+
+  REQUIRE(shadow.flush_dirty() == 1);
+  REQUIRE_FALSE(shadow.dirty());
+  REQUIRE(Config0{device}.read() == 0x0240);
+  REQUIRE(Config1{device}.read() == 0x0123);
+
+  REQUIRE(shadow.flush_dirty() == 0);
+
+  config1.write<Config1::Threshold>(0x456);
+  Config2{shadow}.write(0xCAFE);
+
+  REQUIRE(shadow.flush_dirty() == 2);
+  REQUIRE(Config1{device}.read() == 0x0456);
+  REQUIRE(Config2{device}.read() == 0xCAFE);
+}
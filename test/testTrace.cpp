@@ -0,0 +1,152 @@
+#include <Register.h>
+#include <RegisterArray.h>
+#include <RegisterPack.h>
+
+#include <catch2/catch_all.hpp>
+
+#include <sstream>
+
+using namespace regs;
+
+struct Traced : Register<Traced, uint32_t> {
+  using Enable = Field<Traced, 0, 1>;
+  using Mode = Field<Traced, 1, 3>;
+  using Lane = FieldArray<Traced, 8, 4, 4, 4, 0, read_write, uint8_t>;
+};
+
+struct Untraced : Register<Untraced, uint32_t> {
+  using Enable = Field<Untraced, 0, 1>;
+};
+
+using TracedPolicy = ring_trace<8>;
+
+template <> struct regs::trace_policy<Traced> {
+  using type = TracedPolicy;
+};
+
+struct SlotPack : RegisterPack<8> {
+  using RegisterPack::RegisterPack;
+};
+
+template <unsigned Offset>
+struct Slot : PackedRegister<SlotPack, Slot<Offset>, Offset, uint16_t> {
+  using PackedRegister<SlotPack, Slot<Offset>, Offset,
+                       uint16_t>::PackedRegister;
+};
+
+using Slots = RegisterArray<Slot, 0, 4>;
+
+template <unsigned Offset> struct regs::trace_policy<Slot<Offset>> {
+  using type = TracedPolicy;
+};
+
+/**
+ * @brief stats of the field of Traced named field, null if never accessed
+ *
+ */
+static const trace_stats *find_stats(std::string_view field) {
+  const trace_stats *found = nullptr;
+  TracedPolicy::for_each_stats([&](const trace_stats &stats) {
+    if (stats.field_name == field) {
+      found = &stats;
+    }
+  });
+  return found;
+}
+
+TEST_CASE("TracePolicy", "[trace]") {
+  STATIC_REQUIRE(trace_policy<Traced>::type::enabled);
+#if !defined(REGS_TRACE)
+  STATIC_REQUIRE_FALSE(trace_policy<Untraced>::type::enabled);
+#endif
+
+  Untraced untraced;
+  untraced.write<Untraced::Enable>(1);
+  REQUIRE(untraced.read<Untraced::Enable>() == 1);
+}
+
+TEST_CASE("TraceCounters", "[trace]") {
+  TracedPolicy::reset();
+
+  Traced reg;
+  reg.write<Traced::Enable>(1);
+  reg.write<Traced::Mode>(5);
+  reg.write<Traced::Mode>(3);
+  REQUIRE(reg.read<Traced::Mode>() == 3);
+  reg.write<Traced::Lane>(2, 0xA);
+  REQUIRE(reg.read<Traced::Lane, 2>() == 0xA);
+
+  const auto *mode = find_stats(details::type_name<Traced::Mode>());
+  REQUIRE(mode != nullptr);
+  REQUIRE(mode->reg_name == details::type_name<Traced>());
+  REQUIRE(mode->writes == 2);
+  REQUIRE(mode->reads == 1);
+  REQUIRE(mode->last_value == 3);
+  REQUIRE(mode->last_timestamp > 0);
+
+  const auto *lane = find_stats(details::type_name<Traced::Lane>());
+  REQUIRE(lane != nullptr);
+  REQUIRE(lane->writes == 1);
+  REQUIRE(lane->reads == 1);
+
+  auto events = TracedPolicy::events();
+  REQUIRE(events.size() == 6);
+  REQUIRE(events[0].op == trace_op::write);
+  REQUIRE(events[0].value == 1);
+  REQUIRE(events[0].reg == &reg);
+  REQUIRE(events[4].field == lane);
+  REQUIRE(events[4].index == 2);
+  REQUIRE(events[5].op == trace_op::read);
+  REQUIRE(events[5].value == 0xA);
+
+  for (std::size_t i = 1; i < events.size(); i++) {
+    REQUIRE(events[i].timestamp >= events[i - 1].timestamp);
+  }
+}
+
+TEST_CASE("TraceRegisterArray", "[trace]") {
+  TracedPolicy::reset();
+
+  SlotPack pack;
+
+  // every access path of a register array is recorded like at<Index>()
+  Slots::write<1>(pack, 0x11);
+  Slots::write(pack, 2, 0x22);
+  REQUIRE(Slots::read<1>(pack) == 0x11);
+  REQUIRE(Slots::read(pack, 2) == 0x22);
+  REQUIRE(Slots::at<3>(pack).read() == 0);
+
+  REQUIRE(TracedPolicy::recorded() == 5);
+
+  auto events = TracedPolicy::events();
+  REQUIRE(events[1].op == trace_op::write);
+  REQUIRE(events[1].value == 0x22);
+  REQUIRE(events[1].reg == pack._target.data() + 4);
+  REQUIRE(events[2].op == trace_op::read);
+  REQUIRE(events[2].field == events[0].field);
+  REQUIRE(events[3].field->reg_name == details::type_name<Slot<4>>());
+  REQUIRE(events[4].field->reg_name == details::type_name<Slot<6>>());
+}
+
+TEST_CASE("TraceRing", "[trace]") {
+  TracedPolicy::reset();
+
+  Traced reg;
+  for (uint8_t i = 0; i < 12; i++) {
+    reg.write<Traced::Mode>(i % 8);
+  }
+
+  // multi field writes record every field
+  reg.modify<Traced::Enable, Traced::Mode>(1, 2);
+
+  REQUIRE(TracedPolicy::recorded() == 14);
+
+  auto events = TracedPolicy::events();
+  REQUIRE(events.size() == TracedPolicy::capacity);
+  REQUIRE(events[0].value == 6 % 8);
+  REQUIRE(events[7].value == 2);
+
+  std::ostringstream out;
+  TracedPolicy::dump(out);
+  REQUIRE(out.str().find("writes=13") != std::string::npos);
+}